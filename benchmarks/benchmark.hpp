@@ -0,0 +1,47 @@
+#ifndef MRT_BENCHMARKS_BENCHMARK_HPP_
+#define MRT_BENCHMARKS_BENCHMARK_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+
+// Each benchmark is a standalone program, built with optimizations, e.g.
+//     g++ -std=c++20 -O2 -pthread -I. benchmarks/bounded_arithmetic.cpp
+
+namespace mrt { namespace benchmarks {
+    // Keeps value, and the work that produced it, from being optimized away.
+    template<typename T>
+    inline void keep(const T& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    // Runs body (which performs operations units of work) a few times and
+    // prints the fastest run in nanoseconds per operation.
+    template<typename t_body>
+    double measure(const char* name, std::size_t operations, t_body&& body, std::size_t runs = 5) {
+        using clock = std::chrono::steady_clock;
+
+        double best{ 0 };
+        for (std::size_t run = 0; run < runs; ++run) {
+            const auto start = clock::now();
+            body();
+            const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+            best = run == 0 ? elapsed : std::min(best, elapsed);
+        }
+
+        const double per_operation = best / static_cast<double>(operations);
+        std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << per_operation << " ns/op" << std::endl;
+        return per_operation;
+    }
+} }
+
+#endif
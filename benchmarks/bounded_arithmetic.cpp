@@ -0,0 +1,116 @@
+// Compares the bounded arithmetic operators with plain int arithmetic and
+// with the previous operators, which computed value <op> operand in the
+// value type and only then checked the range. Where the static range makes
+// overflow impossible the new operators should match the previous ones;
+// elsewhere the overflow check is the only added cost.
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "../types/bounded/bounded.hpp"
+
+using namespace mrt::types::bounded;
+using mrt::benchmarks::keep;
+using mrt::benchmarks::measure;
+
+namespace {
+    constexpr std::size_t count = 1 << 16;
+    constexpr std::size_t rounds = 64;
+
+    // [0, 1000] + int16_t cannot overflow an int: the check is compiled out.
+    using narrow = bounded_range<int, 0, 1000>;
+
+    // A range touching the int limits with an int operand keeps the check.
+    using wide = bounded_range<int, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()>;
+
+    template<typename t_bounded_type, typename t_operand>
+    void compare(const char* label, const std::vector<int>& raw, const std::vector<t_operand>& operands) {
+        std::vector<t_bounded_type> values;
+        values.reserve(raw.size());
+        for (const int value : raw) {
+            values.emplace_back(int{ value });
+        }
+
+        const std::string prefix{ label };
+
+        measure((prefix + " int +").c_str(), count * rounds, [&] {
+            long long sum{ 0 };
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    sum += raw[i] + operands[i];
+                }
+            }
+            keep(sum);
+        });
+
+        measure((prefix + " previous operator+").c_str(), count * rounds, [&] {
+            long long sum{ 0 };
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    sum += t_bounded_type(int(values[i].value() + operands[i])).value();
+                }
+            }
+            keep(sum);
+        });
+
+        measure((prefix + " operator+").c_str(), count * rounds, [&] {
+            long long sum{ 0 };
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    sum += (values[i] + operands[i]).value();
+                }
+            }
+            keep(sum);
+        });
+
+        measure((prefix + " previous operator*").c_str(), count * rounds, [&] {
+            long long sum{ 0 };
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    sum += t_bounded_type(int(values[i].value() * (operands[i] & 1))).value();
+                }
+            }
+            keep(sum);
+        });
+
+        measure((prefix + " operator*").c_str(), count * rounds, [&] {
+            long long sum{ 0 };
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    const t_bounded_type& value = values[i];
+                    sum += (value * t_operand(operands[i] & 1)).value();
+                }
+            }
+            keep(sum);
+        });
+    }
+}
+
+int main() {
+    std::mt19937 generator{ 42 };
+
+    std::vector<int> small_values(count);
+    std::vector<std::int16_t> small_operands(count);
+    std::uniform_int_distribution<int> small{ 0, 500 };
+    for (std::size_t i = 0; i < count; ++i) {
+        small_values[i] = small(generator);
+        small_operands[i] = static_cast<std::int16_t>(small(generator));
+    }
+
+    std::vector<int> large_values(count);
+    std::vector<int> large_operands(count);
+    std::uniform_int_distribution<int> large{ -(1 << 29), 1 << 29 };
+    for (std::size_t i = 0; i < count; ++i) {
+        large_values[i] = large(generator);
+        large_operands[i] = large(generator);
+    }
+
+    compare<narrow>("narrow range,", small_values, small_operands);
+    compare<wide>("wide range,", large_values, large_operands);
+
+    return 0;
+}
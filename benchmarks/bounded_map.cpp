@@ -0,0 +1,114 @@
+// bounded_map against std::unordered_map and std::map as per-key counters,
+// over a dense domain (most keys of a small range in use, like HTTP status
+// codes) and a sparse one (a few keys of a 64Ki range): increments by key,
+// then a full iteration.
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "../types/bounded/bounded_map.hpp"
+
+using namespace mrt::types::bounded;
+using mrt::benchmarks::keep;
+using mrt::benchmarks::measure;
+
+namespace {
+    constexpr std::size_t lookups = 1 << 20;
+
+    template<typename t_key>
+    void compare(const char* label, std::size_t used_keys) {
+        constexpr int lower = t_key::constraint_type::lower;
+        constexpr int upper = t_key::constraint_type::upper;
+
+        std::mt19937 generator{ 7 };
+        std::vector<int> domain;
+        for (int key = lower; key <= upper; ++key) {
+            domain.push_back(key);
+        }
+        std::shuffle(domain.begin(), domain.end(), generator);
+        domain.resize(used_keys);
+
+        std::uniform_int_distribution<std::size_t> pick{ 0, used_keys - 1 };
+        std::vector<int> keys(lookups);
+        for (auto& key : keys) {
+            key = domain[pick(generator)];
+        }
+
+        bounded_map<t_key, long long> flat;
+        std::unordered_map<int, long long> hashed;
+        std::map<int, long long> ordered;
+        for (const int key : domain) {
+            flat[t_key(int{ key })] = 0;
+            hashed[key] = 0;
+            ordered[key] = 0;
+        }
+
+        const std::string prefix{ label };
+
+        measure((prefix + " bounded_map increment").c_str(), lookups, [&] {
+            for (const int key : keys) {
+                ++*flat.find(t_key(int{ key }));
+            }
+        });
+
+        measure((prefix + " unordered_map increment").c_str(), lookups, [&] {
+            for (const int key : keys) {
+                ++hashed.find(key)->second;
+            }
+        });
+
+        measure((prefix + " map increment").c_str(), lookups, [&] {
+            for (const int key : keys) {
+                ++ordered.find(key)->second;
+            }
+        });
+
+        constexpr std::size_t sweeps = 256;
+
+        measure((prefix + " bounded_map iterate").c_str(), sweeps * used_keys, [&] {
+            long long sum{ 0 };
+            for (std::size_t sweep = 0; sweep < sweeps; ++sweep) {
+                for (const auto value : flat) {
+                    sum += value;
+                }
+            }
+            keep(sum);
+        });
+
+        measure((prefix + " unordered_map iterate").c_str(), sweeps * used_keys, [&] {
+            long long sum{ 0 };
+            for (std::size_t sweep = 0; sweep < sweeps; ++sweep) {
+                for (const auto& entry : hashed) {
+                    sum += entry.second;
+                }
+            }
+            keep(sum);
+        });
+
+        measure((prefix + " map iterate").c_str(), sweeps * used_keys, [&] {
+            long long sum{ 0 };
+            for (std::size_t sweep = 0; sweep < sweeps; ++sweep) {
+                for (const auto& entry : ordered) {
+                    sum += entry.second;
+                }
+            }
+            keep(sum);
+        });
+
+        keep(flat);
+        keep(hashed);
+        keep(ordered);
+    }
+}
+
+int main() {
+    compare<bounded_range<int, 100, 599>>("dense (400 of 500),", 400);
+    compare<bounded_range<int, 0, 65535>>("sparse (64 of 65536),", 64);
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+// A 512 MiB circular_list<std::uint64_t> on the default resource (global
+// new, as before mapped_resource), on mapped_resource with regular pages
+// and on mapped_resource with transparent huge pages: construction, the
+// first fill (where unfaulted pages are touched on the hot path) and random
+// reads, which are bound by TLB misses. dTLB load misses are counted with
+// perf_event_open where the kernel allows it.
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "benchmark.hpp"
+#include "../containers/circular_list.hpp"
+#include "../system/memory.hpp"
+
+using mrt::benchmarks::keep;
+using mrt::benchmarks::measure;
+using mrt::containers::circular_list;
+using namespace mrt::system;
+
+namespace {
+    constexpr std::size_t ring_bytes = std::size_t{ 512 } << 20;
+    constexpr std::size_t ring_size = ring_bytes / sizeof(std::uint64_t) - 1;
+    constexpr std::size_t reads = std::size_t{ 1 } << 24;
+
+    // dTLB read misses of this thread, or nothing when counters are not
+    // available (no PMU in a VM, perf_event_paranoid, other platforms).
+    class dtlb_counter {
+    public:
+        dtlb_counter() noexcept {
+#if defined(__linux__)
+            perf_event_attr attributes{};
+            attributes.type = PERF_TYPE_HW_CACHE;
+            attributes.size = sizeof(attributes);
+            attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+
+            m_descriptor = static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+        }
+
+        ~dtlb_counter() {
+#if defined(__linux__)
+            if (m_descriptor >= 0) ::close(m_descriptor);
+#endif
+        }
+
+        void start() noexcept {
+#if defined(__linux__)
+            if (m_descriptor >= 0) {
+                ::ioctl(m_descriptor, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(m_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        std::string stop() noexcept {
+#if defined(__linux__)
+            std::uint64_t misses{ 0 };
+            if (m_descriptor >= 0 && ::ioctl(m_descriptor, PERF_EVENT_IOC_DISABLE, 0) == 0
+                && ::read(m_descriptor, &misses, sizeof(misses)) == sizeof(misses)) {
+                return std::to_string(misses);
+            }
+#endif
+            return "n/a";
+        }
+
+    private:
+        int m_descriptor{ -1 };
+    };
+
+    void run(const char* label, std::pmr::memory_resource* resource, const std::vector<std::size_t>& indices) {
+        const std::string prefix{ label };
+        circular_list<std::uint64_t>* ring{ nullptr };
+
+        measure((prefix + " construct, per MiB").c_str(), ring_bytes >> 20, [&] {
+            ring = new circular_list<std::uint64_t>(ring_size, resource);
+        }, 1);
+
+        measure((prefix + " first fill").c_str(), ring_size, [&] {
+            const auto slots = ring->writable_segments();
+            std::uint64_t value{ 0 };
+            for (auto& slot : slots.first) slot = value++;
+            for (auto& slot : slots.second) slot = value++;
+            ring->commit(slots.size());
+        }, 1);
+
+        dtlb_counter counter;
+        counter.start();
+
+        measure((prefix + " random reads").c_str(), reads, [&] {
+            const auto data = ring->readable_segments().first;
+            std::uint64_t sum{ 0 };
+            for (const auto index : indices) {
+                sum += data[index];
+            }
+            keep(sum);
+        }, 3);
+
+        std::cout << prefix << " dTLB read misses over 3 read passes: " << counter.stop() << std::endl;
+        delete ring;
+    }
+}
+
+int main() {
+    std::mt19937_64 generator{ 3 };
+    std::uniform_int_distribution<std::size_t> position{ 0, ring_size - 1 };
+    std::vector<std::size_t> indices(reads);
+    for (auto& index : indices) {
+        index = position(generator);
+    }
+
+    run("new[]         ", std::pmr::new_delete_resource(), indices);
+
+    mapped_resource normal{ mapped_options{ page_policy::normal } };
+    run("mapped, 4 KiB ", &normal, indices);
+
+    mapped_resource huge{ mapped_options{ page_policy::transparent_huge } };
+    run("mapped, THP   ", &huge, indices);
+
+    return 0;
+}
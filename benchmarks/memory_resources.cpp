@@ -0,0 +1,116 @@
+// Allocation-heavy loads on glibc malloc (through new/delete and the
+// default memory resource) and on arena_resource and pool_resource: a
+// request handler creating and destroying small circular_lists, and raw
+// small-block allocate/deallocate pairs with several blocks alive.
+
+#include <cstdlib>
+#include <memory_resource>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "../containers/circular_list.hpp"
+#include "../system/memory.hpp"
+
+using mrt::benchmarks::keep;
+using mrt::benchmarks::measure;
+using mrt::containers::circular_list;
+using namespace mrt::system;
+
+namespace {
+    constexpr std::size_t requests = 20000;
+    constexpr std::size_t rings_per_request = 24;
+    constexpr std::size_t ring_size = 15;
+
+    // One request: a few dozen short-lived rings, each filled and read once.
+    void handle_request(std::pmr::memory_resource* resource, long long& sum) {
+        for (std::size_t ring = 0; ring < rings_per_request; ++ring) {
+            circular_list<int> list(ring_size, resource);
+
+            for (int i = 0; i < 20; ++i) {
+                list.push(i);
+            }
+
+            sum += list.front() + list.back();
+        }
+    }
+
+    void rings() {
+        measure("rings, default resource (malloc)", requests * rings_per_request, [] {
+            long long sum{ 0 };
+            for (std::size_t request = 0; request < requests; ++request) {
+                handle_request(std::pmr::get_default_resource(), sum);
+            }
+            keep(sum);
+        });
+
+        measure("rings, arena_resource rewound per request", requests * rings_per_request, [] {
+            arena_resource arena;
+            long long sum{ 0 };
+            for (std::size_t request = 0; request < requests; ++request) {
+                handle_request(&arena, sum);
+                arena.rewind();
+            }
+            keep(sum);
+        });
+
+        measure("rings, pool_resource", requests * rings_per_request, [] {
+            pool_resource pool{ (ring_size + 1) * sizeof(int) };
+            long long sum{ 0 };
+            for (std::size_t request = 0; request < requests; ++request) {
+                handle_request(&pool, sum);
+            }
+            keep(sum);
+        });
+    }
+
+    void blocks() {
+        constexpr std::size_t rounds = 20000;
+        constexpr std::size_t live = 64;
+        constexpr std::size_t size = 64;
+
+        std::vector<void*> blocks(live);
+
+        measure("64 B blocks, malloc/free", rounds * live, [&] {
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (auto& block : blocks) {
+                    block = std::malloc(size);
+                    keep(block);
+                }
+                for (auto* block : blocks) {
+                    std::free(block);
+                }
+            }
+        });
+
+        measure("64 B blocks, pool_resource", rounds * live, [&] {
+            pool_resource pool{ size };
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (auto& block : blocks) {
+                    block = pool.allocate(size);
+                    keep(block);
+                }
+                for (auto* block : blocks) {
+                    pool.deallocate(block, size);
+                }
+            }
+        });
+
+        measure("64 B blocks, arena_resource", rounds * live, [&] {
+            arena_resource arena;
+            for (std::size_t round = 0; round < rounds; ++round) {
+                for (auto& block : blocks) {
+                    block = arena.allocate(size);
+                    keep(block);
+                }
+                arena.rewind();
+            }
+        });
+    }
+}
+
+int main() {
+    rings();
+    blocks();
+
+    return 0;
+}
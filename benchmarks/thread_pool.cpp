@@ -0,0 +1,159 @@
+// thread_pool against a naive pool (one std::deque of std::function under a
+// mutex and a condition variable): the cost of spawning many small tasks,
+// the submit-to-run round trip of a single task, and parallel_for over an
+// array at 1, 2 and 4 threads.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "../system/thread_pool.hpp"
+
+using mrt::benchmarks::keep;
+using mrt::benchmarks::measure;
+using mrt::system::thread_pool;
+
+namespace {
+    class mutex_pool {
+    public:
+        explicit mutex_pool(std::size_t threads) {
+            for (std::size_t i = 0; i < threads; ++i) {
+                m_workers.emplace_back([this] { work(); });
+            }
+        }
+
+        ~mutex_pool() {
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_stopping = true;
+            }
+
+            m_ready.notify_all();
+            for (auto& worker : m_workers) {
+                worker.join();
+            }
+        }
+
+        void submit(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_tasks.push_back(std::move(task));
+            }
+
+            m_ready.notify_one();
+        }
+
+        template<typename t_body>
+        void parallel_for(std::size_t first, std::size_t last, t_body&& body) {
+            const std::size_t chunks = m_workers.size() * 4;
+            const std::size_t grain = (last - first + chunks - 1) / chunks;
+            std::atomic<std::size_t> remaining{ (last - first + grain - 1) / grain };
+
+            for (std::size_t begin = first; begin < last; begin += grain) {
+                const std::size_t end = std::min(begin + grain, last);
+                submit([&body, &remaining, begin, end] {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        body(i);
+                    }
+                    remaining.fetch_sub(1, std::memory_order_release);
+                });
+            }
+
+            while (remaining.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        void work() {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock{ m_mutex };
+                    m_ready.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+
+                    if (m_tasks.empty()) {
+                        return;
+                    }
+
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+
+                task();
+            }
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_ready;
+        std::deque<std::function<void()>> m_tasks;
+        bool m_stopping{ false };
+        std::vector<std::thread> m_workers;
+    };
+
+    void wait_for(const std::atomic<std::size_t>& counter, std::size_t expected) {
+        while (counter.load(std::memory_order_acquire) != expected) {
+            std::this_thread::yield();
+        }
+    }
+
+    template<typename t_pool>
+    void spawn(const char* label, std::size_t threads) {
+        constexpr std::size_t tasks = 100000;
+        t_pool pool{ threads };
+
+        measure((std::string{ label } + " spawn " + std::to_string(tasks) + " tasks").c_str(), tasks, [&pool] {
+            std::atomic<std::size_t> done{ 0 };
+            for (std::size_t i = 0; i < tasks; ++i) {
+                pool.submit([&done] { done.fetch_add(1, std::memory_order_release); });
+            }
+            wait_for(done, tasks);
+        });
+
+        constexpr std::size_t round_trips = 2000;
+        measure((std::string{ label } + " submit-to-run round trip").c_str(), round_trips, [&pool] {
+            std::atomic<std::size_t> done{ 0 };
+            for (std::size_t i = 0; i < round_trips; ++i) {
+                pool.submit([&done] { done.fetch_add(1, std::memory_order_release); });
+                wait_for(done, i + 1);
+            }
+        });
+    }
+
+    template<typename t_pool>
+    void scale(const char* label, std::size_t threads) {
+        constexpr std::size_t count = 1 << 22;
+        static std::vector<double> values(count, 1.5);
+
+        t_pool pool{ threads };
+        const auto name = std::string{ label } + " parallel_for, " + std::to_string(threads) + " threads";
+
+        measure(name.c_str(), count, [&pool] {
+            pool.parallel_for(std::size_t{ 0 }, count, [](std::size_t i) { values[i] = std::sqrt(values[i] * values[i] + 1.0); });
+        });
+
+        keep(values[count / 2]);
+    }
+}
+
+int main() {
+    spawn<thread_pool>("thread_pool", 2);
+    spawn<mutex_pool>("mutex_pool ", 2);
+
+    for (const std::size_t threads : { 1, 2, 4 }) {
+        scale<thread_pool>("thread_pool", threads);
+        scale<mutex_pool>("mutex_pool ", threads);
+    }
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    return 0;
+}
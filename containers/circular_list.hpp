@@ -5,6 +5,10 @@
 #include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
+
+#include "segment.hpp"
 
 namespace mrt { namespace containers {
 
@@ -161,6 +165,7 @@ namespace mrt { namespace containers {
 
     private:
         size_type max_size;        
+        std::pmr::memory_resource* resource;
         pointer buffer;
         pointer head;
         pointer tail;
@@ -168,24 +173,28 @@ namespace mrt { namespace containers {
     public:
         circular_list() = delete;
 
-        explicit circular_list(size_type max_size) 
+        // The buffer comes from resource (e.g. a mrt::system arena or pool),
+        // which must outlive the list.
+        explicit circular_list(size_type max_size, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) 
             : max_size{max_size}, 
-            buffer{new value_type[max_size + 1]},
+            resource{resource},
+            buffer{allocate(max_size + 1)},
             head{buffer},
             tail{buffer} 
         {
         }
         
-        explicit circular_list(std::initializer_list<value_type> list) 
+        explicit circular_list(std::initializer_list<value_type> list, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) 
             : max_size{list.size()},
-            buffer{new value_type[list.size() + 1]},
+            resource{resource},
+            buffer{allocate(list.size() + 1)},
             head{buffer + list.size()},
             tail{buffer}
         {
             try {
                 std::copy(std::rbegin(list), std::rend(list), begin());
             } catch (...) {
-                delete [] buffer;
+                deallocate();
                 throw;
             }
         }
@@ -193,23 +202,25 @@ namespace mrt { namespace containers {
         template<typename It>
         circular_list(It first, It last)
             : max_size{std::distance(first, last)} ,
-              buffer{new value_type[max_size + 1]},
+              resource{std::pmr::get_default_resource()},
+              buffer{allocate(max_size + 1)},
               head{buffer},
               tail{buffer}
         {
             try {
                 std::copy(first, last, std::begin(buffer));
             } catch (...) {
-                delete [] buffer;
+                deallocate();
                 throw;
             }
         }
 
         circular_list(circular_list&& other) noexcept
             : max_size{other.max_size},
+            resource{other.resource},
             buffer{other.buffer},
-            head{buffer},
-            tail{buffer}
+            head{other.head},
+            tail{other.tail}
         {
             other.buffer = {};
             other.head = {};
@@ -217,9 +228,10 @@ namespace mrt { namespace containers {
             other.max_size = {};
         }
 
-        circular_list(circular_list& other) 
+        circular_list(circular_list& other, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) 
             : max_size{other.max_size},
-            buffer{new value_type[max_size + 1]},
+            resource{resource},
+            buffer{allocate(max_size + 1)},
             head{buffer + 1},
             tail{buffer}
         {
@@ -227,7 +239,7 @@ namespace mrt { namespace containers {
                 std::copy(std::rbegin(other), std::rend(other), begin());
                 head = buffer + max_size;
             } catch (...) {
-                delete [] buffer;
+                deallocate();
                 throw;
             }
         }
@@ -244,7 +256,11 @@ namespace mrt { namespace containers {
         }
         
         circular_list<value_type>& operator=(circular_list<value_type>&& other) {
-            delete [] buffer;
+            if (this == &other) return *this;
+
+            deallocate();
+            max_size = other.max_size;
+            resource = other.resource;
             buffer = other.buffer;
             head = other.head;
             tail = other.tail;
@@ -257,7 +273,11 @@ namespace mrt { namespace containers {
         }
 
         ~circular_list() {
-            delete [] buffer;
+            deallocate();
+        }
+
+        std::pmr::memory_resource* get_resource() const noexcept {
+            return resource;
         }
 
         reference front() noexcept {
@@ -319,6 +339,28 @@ namespace mrt { namespace containers {
             }
         }
 
+        // Free slots after the newest element, in push order. Fill a prefix
+        // (e.g. with a read) and commit() it instead of pushing one by one.
+        segment_pair<value_type> writable_segments() noexcept {
+            return split_ring(buffer, max_size + 1, static_cast<size_type>(head - buffer), max_size - size());
+        }
+
+        // Makes the first count writable slots the newest elements. count
+        // must not exceed writable_segments().size().
+        void commit(size_type count) noexcept {
+            head = buffer + (static_cast<size_type>(head - buffer) + count) % (max_size + 1);
+        }
+
+        // Elements from the oldest to the newest.
+        segment_pair<value_type> readable_segments() noexcept {
+            return split_ring(buffer, max_size + 1, static_cast<size_type>(tail - buffer), size());
+        }
+
+        // Pops the count oldest elements at once.
+        void consume(size_type count) noexcept {
+            tail = buffer + (static_cast<size_type>(tail - buffer) + count) % (max_size + 1);
+        }
+
         iterator begin() noexcept {
             return iterator{ previous(buffer, max_size, head), buffer, max_size };
         }
@@ -350,6 +392,28 @@ namespace mrt { namespace containers {
         const_reverse_iterator crend() const noexcept {
             return const_reverse_iterator{ const_iterator{ previous(buffer, max_size, head), buffer, max_size } };
         }
+
+    private:
+        pointer allocate(size_type count) {
+            auto storage = static_cast<pointer>(resource->allocate(count * sizeof(value_type), alignof(value_type)));
+
+            try {
+                std::uninitialized_default_construct_n(storage, count);
+            } catch (...) {
+                resource->deallocate(storage, count * sizeof(value_type), alignof(value_type));
+                throw;
+            }
+
+            return storage;
+        }
+
+        void deallocate() noexcept {
+            if (buffer == nullptr) return;
+
+            std::destroy_n(buffer, max_size + 1);
+            resource->deallocate(buffer, (max_size + 1) * sizeof(value_type), alignof(value_type));
+            buffer = nullptr;
+        }
     };
 }}
 
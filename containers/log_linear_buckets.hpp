@@ -0,0 +1,47 @@
+#ifndef MRT_CONTAINERS_LOG_LINEAR_BUCKETS_HPP_
+#define MRT_CONTAINERS_LOG_LINEAR_BUCKETS_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace mrt { namespace containers {
+    // Bucket layout of a log-linear histogram over T: values below
+    // 2^sub_bucket_bits have their own bucket, above that every power of two
+    // is split in 2^sub_bucket_bits buckets, so a bucket spans at most
+    // 1/2^sub_bucket_bits of its lower bound.
+    template<typename T, unsigned t_sub_bucket_bits>
+    struct log_linear_buckets {
+        static_assert(std::is_unsigned_v<T>, "log_linear_buckets holds unsigned integers");
+        static_assert(t_sub_bucket_bits >= 1 && t_sub_bucket_bits < std::numeric_limits<T>::digits, "Sub-buckets must leave room for an exponent");
+
+        static constexpr unsigned sub_bucket_bits = t_sub_bucket_bits;
+        static constexpr std::size_t sub_buckets = std::size_t{ 1 } << sub_bucket_bits;
+        static constexpr std::size_t bucket_count = (std::numeric_limits<T>::digits - sub_bucket_bits + 1) * sub_buckets;
+
+        static constexpr std::size_t bucket_of(T value) noexcept {
+            if (value < sub_buckets) {
+                return static_cast<std::size_t>(value);
+            }
+
+            const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - sub_bucket_bits;
+            return (shift + 1) * sub_buckets + static_cast<std::size_t>((value >> shift) & (sub_buckets - 1));
+        }
+
+        static constexpr T lower_bound_of(std::size_t bucket) noexcept {
+            if (bucket < sub_buckets) {
+                return static_cast<T>(bucket);
+            }
+
+            const auto shift = bucket / sub_buckets - 1;
+            return static_cast<T>(static_cast<T>(sub_buckets + bucket % sub_buckets) << shift);
+        }
+
+        static constexpr T width_of(std::size_t bucket) noexcept {
+            return bucket < sub_buckets ? T{ 1 } : static_cast<T>(T{ 1 } << (bucket / sub_buckets - 1));
+        }
+    };
+} }
+
+#endif
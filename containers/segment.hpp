@@ -0,0 +1,49 @@
+#ifndef MRT_CONTAINERS_SEGMENT_HPP_
+#define MRT_CONTAINERS_SEGMENT_HPP_
+
+#include <cstddef>
+#include <span>
+
+namespace mrt { namespace containers {
+    // A ring range as at most two contiguous spans: first runs up to the
+    // end of the buffer, second restarts at its beginning and is empty
+    // when the range does not wrap. Loops over each span vectorize.
+    template<typename T>
+    struct segment_pair {
+        std::span<T> first;
+        std::span<T> second;
+
+        std::size_t size() const noexcept {
+            return first.size() + second.size();
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        T& operator[](std::size_t index) const noexcept {
+            return index < first.size() ? first[index] : second[index - first.size()];
+        }
+
+        template<typename t_function>
+        void for_each(t_function&& function) const {
+            for (auto& value : first) function(value);
+            for (auto& value : second) function(value);
+        }
+    };
+
+    // Splits count elements of a ring of capacity slots, starting at slot
+    // start, at the wrap point.
+    template<typename T>
+    segment_pair<T> split_ring(T* buffer, std::size_t capacity, std::size_t start, std::size_t count) noexcept {
+        const std::size_t until_end = capacity - start;
+
+        if (count <= until_end) {
+            return { std::span<T>{ buffer + start, count }, std::span<T>{} };
+        }
+
+        return { std::span<T>{ buffer + start, until_end }, std::span<T>{ buffer, count - until_end } };
+    }
+} }
+
+#endif
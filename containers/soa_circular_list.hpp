@@ -0,0 +1,209 @@
+#ifndef MRT_CONTAINERS_SOA_CIRCULAR_LIST_HPP_
+#define MRT_CONTAINERS_SOA_CIRCULAR_LIST_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "segment.hpp"
+
+namespace mrt { namespace containers {
+    // Ring of records stored as one column per field: soa_circular_list<
+    // std::uint64_t, std::uint32_t, double> keeps three arrays sharing a
+    // head and a size. A scan of one field reads only that column, as one
+    // or two contiguous spans. Like circular_list, pushing into a full ring
+    // overwrites the oldest record; front() is the newest, back() the
+    // oldest, and logical index 0 is the oldest.
+    template<typename... Ts>
+    class soa_circular_list {
+        static_assert(sizeof...(Ts) > 0, "soa_circular_list needs at least one column");
+
+    public:
+        using size_type = std::size_t;
+        using value_type = std::tuple<Ts...>;
+        using reference = std::tuple<Ts&...>;
+        using const_reference = std::tuple<const Ts&...>;
+
+        template<std::size_t I>
+        using column_type = std::tuple_element_t<I, value_type>;
+
+        // Columns start on a cache line so the first span loads aligned.
+        static constexpr std::size_t column_alignment = 64;
+
+    public:
+        soa_circular_list() = delete;
+
+        explicit soa_circular_list(size_type capacity, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : m_capacity{ capacity }, m_resource{ resource } {
+            allocate(std::index_sequence_for<Ts...>{});
+        }
+
+        soa_circular_list(const soa_circular_list&) = delete;
+        soa_circular_list& operator=(const soa_circular_list&) = delete;
+
+        soa_circular_list(soa_circular_list&& other) noexcept
+            : m_capacity{ other.m_capacity }, m_resource{ other.m_resource }, m_columns{ other.m_columns },
+              m_head{ other.m_head }, m_size{ other.m_size } {
+            other.m_columns = {};
+            other.m_capacity = other.m_head = other.m_size = 0;
+        }
+
+        soa_circular_list& operator=(soa_circular_list&& other) noexcept {
+            if (this == &other) return *this;
+
+            deallocate(std::index_sequence_for<Ts...>{});
+            m_capacity = other.m_capacity;
+            m_resource = other.m_resource;
+            m_columns = other.m_columns;
+            m_head = other.m_head;
+            m_size = other.m_size;
+
+            other.m_columns = {};
+            other.m_capacity = other.m_head = other.m_size = 0;
+            return *this;
+        }
+
+        ~soa_circular_list() {
+            deallocate(std::index_sequence_for<Ts...>{});
+        }
+
+        // Writes one field per column at the same slot.
+        template<typename... Us>
+            requires (sizeof...(Us) == sizeof...(Ts) && (std::is_assignable_v<Ts&, Us> && ...))
+        void push(Us&&... values) {
+            if (m_capacity == 0) return;
+
+            store(std::index_sequence_for<Ts...>{}, std::forward<Us>(values)...);
+            m_head = m_head + 1 == m_capacity ? 0 : m_head + 1;
+
+            if (m_size < m_capacity) {
+                ++m_size;
+            }
+        }
+
+        void push(const value_type& record) {
+            std::apply([this](const Ts&... values) { push(values...); }, record);
+        }
+
+        // Drops the oldest record.
+        void pop() noexcept {
+            if (m_size != 0) {
+                --m_size;
+            }
+        }
+
+        void clear() noexcept {
+            m_head = 0;
+            m_size = 0;
+        }
+
+        size_type size() const noexcept { return m_size; }
+        size_type capacity() const noexcept { return m_capacity; }
+        bool empty() const noexcept { return m_size == 0; }
+        bool full() const noexcept { return m_size == m_capacity; }
+
+        // Record at logical index (0 is the oldest).
+        reference operator[](size_type index) noexcept {
+            return row(slot(index), std::index_sequence_for<Ts...>{});
+        }
+
+        const_reference operator[](size_type index) const noexcept {
+            return row(slot(index), std::index_sequence_for<Ts...>{});
+        }
+
+        reference front() noexcept { return (*this)[m_size - 1]; }
+        const_reference front() const noexcept { return (*this)[m_size - 1]; }
+        reference back() noexcept { return (*this)[0]; }
+        const_reference back() const noexcept { return (*this)[0]; }
+
+        // Column I from oldest to newest.
+        template<std::size_t I>
+        segment_pair<column_type<I>> column() noexcept {
+            return split_ring(std::get<I>(m_columns), m_capacity, oldest(), m_size);
+        }
+
+        template<std::size_t I>
+        segment_pair<const column_type<I>> column() const noexcept {
+            return split_ring<const column_type<I>>(std::get<I>(m_columns), m_capacity, oldest(), m_size);
+        }
+
+    private:
+        size_type oldest() const noexcept {
+            return m_head >= m_size ? m_head - m_size : m_head + m_capacity - m_size;
+        }
+
+        size_type slot(size_type index) const noexcept {
+            const size_type position = oldest() + index;
+            return position >= m_capacity ? position - m_capacity : position;
+        }
+
+        template<std::size_t... Is>
+        reference row(size_type at, std::index_sequence<Is...>) noexcept {
+            return reference{ std::get<Is>(m_columns)[at]... };
+        }
+
+        template<std::size_t... Is>
+        const_reference row(size_type at, std::index_sequence<Is...>) const noexcept {
+            return const_reference{ std::get<Is>(m_columns)[at]... };
+        }
+
+        template<std::size_t... Is, typename... Us>
+        void store(std::index_sequence<Is...>, Us&&... values) {
+            ((std::get<Is>(m_columns)[m_head] = std::forward<Us>(values)), ...);
+        }
+
+        template<std::size_t... Is>
+        void allocate(std::index_sequence<Is...>) {
+            try {
+                (allocate_column<Is>(), ...);
+            } catch (...) {
+                deallocate(std::index_sequence<Is...>{});
+                throw;
+            }
+        }
+
+        template<std::size_t I>
+        void allocate_column() {
+            using T = column_type<I>;
+            auto* storage = static_cast<T*>(m_resource->allocate(m_capacity * sizeof(T), column_alignment));
+
+            try {
+                std::uninitialized_default_construct_n(storage, m_capacity);
+            } catch (...) {
+                m_resource->deallocate(storage, m_capacity * sizeof(T), column_alignment);
+                throw;
+            }
+
+            std::get<I>(m_columns) = storage;
+        }
+
+        template<std::size_t... Is>
+        void deallocate(std::index_sequence<Is...>) noexcept {
+            (deallocate_column<Is>(), ...);
+        }
+
+        template<std::size_t I>
+        void deallocate_column() noexcept {
+            using T = column_type<I>;
+            auto*& storage = std::get<I>(m_columns);
+
+            if (storage == nullptr) return;
+
+            std::destroy_n(storage, m_capacity);
+            m_resource->deallocate(storage, m_capacity * sizeof(T), column_alignment);
+            storage = nullptr;
+        }
+
+    private:
+        size_type m_capacity;
+        std::pmr::memory_resource* m_resource;
+        std::tuple<Ts*...> m_columns{};
+        size_type m_head{ 0 };
+        size_type m_size{ 0 };
+    };
+} }
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef MRT_CONTAINERS_WINDOWED_QUANTILE_HPP_
+#define MRT_CONTAINERS_WINDOWED_QUANTILE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+#include "circular_list.hpp"
+#include "log_linear_buckets.hpp"
+
+namespace mrt { namespace containers {
+    // The last window_size values of a stream with their quantiles. Next
+    // to the ring, a log-linear histogram is updated on push, on the
+    // eviction of the oldest value and on pop, so quantile() walks the
+    // buckets instead of sorting a copy of the window. Values below
+    // 2^precision_bits are exact; above, a bucket spans 1/2^precision_bits of
+    // its lower bound, which bounds the relative error of a quantile.
+    template<typename T, unsigned t_precision_bits = 5>
+    class windowed_quantile : public log_linear_buckets<T, t_precision_bits> {
+        using buckets = log_linear_buckets<T, t_precision_bits>;
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+        static constexpr unsigned precision_bits = t_precision_bits;
+
+        using buckets::sub_buckets;
+        using buckets::bucket_count;
+        using buckets::bucket_of;
+        using buckets::lower_bound_of;
+        using buckets::width_of;
+
+    public:
+        explicit windowed_quantile(size_type window_size, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : m_window(window_size, resource) {}
+
+        // Adds value; a full window first evicts its oldest value.
+        void push(value_type value) {
+            if (m_window.full()) {
+                remove(m_window.back());
+            }
+
+            m_window.push(value);
+            ++m_counts[bucket_of(value)];
+        }
+
+        // Removes the oldest value. The window must not be empty.
+        void pop() {
+            remove(m_window.back());
+            m_window.pop();
+        }
+
+        void clear() noexcept {
+            m_window.clear();
+            m_counts.fill(0);
+        }
+
+        bool empty() const noexcept {
+            return m_window.empty();
+        }
+
+        size_type size() const noexcept {
+            return m_window.size();
+        }
+
+        const circular_list<value_type>& window() const noexcept {
+            return m_window;
+        }
+
+        // Value of rank floor(q * (size() - 1)) in the window, as the middle
+        // of its bucket; 0 when empty. q is clamped to [0, 1].
+        value_type quantile(double q) const noexcept {
+            const size_type count = size();
+            if (count == 0) {
+                return 0;
+            }
+
+            const auto rank = static_cast<size_type>(std::clamp(q, 0.0, 1.0) * static_cast<double>(count - 1));
+            size_type seen{ 0 };
+
+            for (size_type bucket = 0; bucket < bucket_count; ++bucket) {
+                seen += m_counts[bucket];
+
+                if (seen > rank) {
+                    return static_cast<value_type>(lower_bound_of(bucket) + (width_of(bucket) - 1) / 2);
+                }
+            }
+
+            return 0;
+        }
+
+    private:
+        void remove(value_type value) noexcept {
+            --m_counts[bucket_of(value)];
+        }
+
+    private:
+        circular_list<value_type> m_window;
+        std::array<size_type, bucket_count> m_counts{};
+    };
+} }
+
+#endif
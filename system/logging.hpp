@@ -0,0 +1,530 @@
+#ifndef MRT_SYSTEM_LOGGING_HPP_
+#define MRT_SYSTEM_LOGGING_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "topology.hpp"
+
+namespace mrt { namespace system {
+    enum class overflow_policy {
+        // A full ring drops the record and counts it; the caller never waits.
+        drop,
+        // A full ring makes the caller wait for the writer thread.
+        block
+    };
+
+    struct logger_options {
+        int fd{ 2 };
+        overflow_policy policy{ overflow_policy::drop };
+        // Per thread, rounded up to a power of two.
+        std::size_t records_per_thread{ 1024 };
+        std::chrono::milliseconds flush_interval{ 10 };
+    };
+
+    // Format string of a log call. The writer thread reads it after write()
+    // has returned, so it must outlive the logger: the constructor is
+    // consteval and only accepts a constant expression, such as a literal.
+    class log_pattern {
+    public:
+        consteval log_pattern(const char* text) noexcept : m_text{ text } {}
+
+        const char* text() const noexcept {
+            return m_text;
+        }
+
+    private:
+        const char* m_text;
+    };
+
+    // One log call, with its pattern from a log_pattern; the arguments are
+    // copied into the payload and formatted later by the writer thread
+    // through format.
+    struct alignas(64) log_record {
+        static constexpr std::size_t size = 256;
+        static constexpr std::size_t payload_size = size - 2 * sizeof(void*) - 2 * sizeof(std::uint16_t);
+
+        void (*format)(const log_record&, char*&, char*) noexcept;
+        const char* pattern;
+        std::uint16_t length;
+        std::uint16_t arguments;
+        std::byte payload[payload_size];
+    };
+
+    static_assert(sizeof(log_record) == log_record::size, "log_record must stay one fixed-size slot");
+
+    namespace detail {
+        template<typename T>
+        constexpr bool is_log_string_v = std::is_convertible_v<const T&, std::string_view>;
+
+        template<typename T>
+        using log_stored_t = std::conditional_t<is_log_string_v<T>, std::string_view, std::decay_t<T>>;
+
+        // Strings are copied with a 16-bit length and truncated to the space
+        // left; other arguments are copied as is.
+        template<typename T>
+        bool encode(std::byte*& position, std::byte* end, const T& value) noexcept {
+            if constexpr (is_log_string_v<T>) {
+                const std::string_view text{ value };
+                if (end - position < static_cast<std::ptrdiff_t>(sizeof(std::uint16_t))) {
+                    return false;
+                }
+
+                const auto length = static_cast<std::uint16_t>(std::min<std::size_t>(text.size(), end - position - sizeof(std::uint16_t)));
+                std::memcpy(position, &length, sizeof(length));
+                std::memcpy(position + sizeof(length), text.data(), length);
+                position += sizeof(length) + length;
+            } else {
+                static_assert(std::is_trivially_copyable_v<T>, "Log arguments must be strings or trivially copyable");
+
+                if (end - position < static_cast<std::ptrdiff_t>(sizeof(T))) {
+                    return false;
+                }
+
+                std::memcpy(position, &value, sizeof(T));
+                position += sizeof(T);
+            }
+
+            return true;
+        }
+
+        template<typename T>
+        log_stored_t<T> decode(const std::byte*& position) noexcept {
+            if constexpr (is_log_string_v<T>) {
+                std::uint16_t length;
+                std::memcpy(&length, position, sizeof(length));
+                const std::string_view text{ reinterpret_cast<const char*>(position + sizeof(length)), length };
+                position += sizeof(length) + length;
+                return text;
+            } else {
+                std::decay_t<T> value;
+                std::memcpy(&value, position, sizeof(value));
+                position += sizeof(value);
+                return value;
+            }
+        }
+
+        inline void append(char*& out, char* end, std::string_view text) noexcept {
+            const auto count = std::min<std::size_t>(text.size(), end - out);
+            std::memcpy(out, text.data(), count);
+            out += count;
+        }
+
+        template<typename T>
+        void append_value(char*& out, char* end, const T& value) noexcept {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                append(out, end, value);
+            } else if constexpr (std::is_same_v<T, bool>) {
+                append(out, end, value ? "true" : "false");
+            } else if constexpr (std::is_same_v<T, char>) {
+                append(out, end, std::string_view{ &value, 1 });
+            } else if constexpr (std::is_enum_v<T>) {
+                append_value(out, end, static_cast<std::underlying_type_t<T>>(value));
+            } else if constexpr (std::is_pointer_v<T>) {
+                append(out, end, "0x");
+                append_value(out, end, reinterpret_cast<std::uintptr_t>(value));
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                out = std::to_chars(out, end, value).ptr;
+            } else {
+                append(out, end, "?");
+            }
+        }
+
+        // Copies the pattern up to the next "{}" (unescaping "{{" and "}}")
+        // and returns whether one was found.
+        inline bool advance_pattern(const char*& pattern, char*& out, char* end) noexcept {
+            while (*pattern != '\0') {
+                if ((pattern[0] == '{' && pattern[1] == '{') || (pattern[0] == '}' && pattern[1] == '}')) {
+                    append(out, end, std::string_view{ pattern, 1 });
+                    pattern += 2;
+                } else if (pattern[0] == '{' && pattern[1] == '}') {
+                    pattern += 2;
+                    return true;
+                } else {
+                    append(out, end, std::string_view{ pattern, 1 });
+                    ++pattern;
+                }
+            }
+
+            return false;
+        }
+
+        template<typename T>
+        void format_argument(const char*& pattern, const std::byte*& position, std::size_t& remaining, char*& out, char* end) noexcept {
+            if (remaining == 0 || !advance_pattern(pattern, out, end)) {
+                remaining = 0;
+                return;
+            }
+
+            append_value(out, end, decode<T>(position));
+            --remaining;
+        }
+
+        template<typename... t_arguments>
+        void format_record(const log_record& record, char*& out, char* end) noexcept {
+            const char* pattern = record.pattern;
+            [[maybe_unused]] const std::byte* position = record.payload;
+            [[maybe_unused]] std::size_t remaining = record.arguments;
+
+            (format_argument<t_arguments>(pattern, position, remaining, out, end), ...);
+
+            // Placeholders without an argument are printed as they are.
+            while (advance_pattern(pattern, out, end)) {
+                append(out, end, "{}");
+            }
+        }
+    }
+
+    // Single-producer single-consumer ring of records, one per thread.
+    class log_ring {
+    public:
+        explicit log_ring(std::size_t capacity)
+            : m_records(std::bit_ceil(std::max<std::size_t>(capacity, 2))), m_mask{ m_records.size() - 1 } {}
+
+        // Producer side.
+        log_record* reserve() noexcept {
+            const auto head = m_head.load(std::memory_order_relaxed);
+
+            if (head - m_cached_tail > m_mask) {
+                m_cached_tail = m_tail.load(std::memory_order_acquire);
+
+                if (head - m_cached_tail > m_mask) {
+                    return nullptr;
+                }
+            }
+
+            return &m_records[head & m_mask];
+        }
+
+        void publish() noexcept {
+            m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        void count_drop() noexcept {
+            m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        // Consumer side.
+        std::size_t readable() const noexcept {
+            return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+        }
+
+        const log_record& peek(std::size_t offset) const noexcept {
+            return m_records[(m_tail.load(std::memory_order_relaxed) + offset) & m_mask];
+        }
+
+        void consume(std::size_t count) noexcept {
+            m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+        std::uint64_t dropped() const noexcept {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+        std::size_t published() const noexcept {
+            return m_head.load(std::memory_order_acquire);
+        }
+
+        std::size_t consumed() const noexcept {
+            return m_tail.load(std::memory_order_acquire);
+        }
+
+    public:
+        // Set when the producing thread exits or the logger goes away.
+        std::atomic<bool> abandoned{ false };
+        std::atomic<bool> closed{ false };
+
+    private:
+        std::vector<log_record> m_records;
+        const std::size_t m_mask;
+
+        alignas(hardware_destructive_interference_size) std::atomic<std::size_t> m_head{ 0 };
+        std::size_t m_cached_tail{ 0 };
+        std::atomic<std::uint64_t> m_dropped{ 0 };
+
+        alignas(hardware_destructive_interference_size) std::atomic<std::size_t> m_tail{ 0 };
+    };
+
+    // Asynchronous logger. write() copies its arguments into the calling
+    // thread's ring and returns; a background thread formats the records
+    // and writes them with writev in batches. Lines are ordered per thread,
+    // not across threads.
+    class logger {
+    public:
+        static constexpr std::size_t max_line = 512;
+        static constexpr std::size_t batch_records = 64;
+
+        explicit logger(logger_options options = {})
+            : m_options{ options }, m_id{ next_id() }, m_writer{ [this] { run(); } } {}
+
+        logger(const logger&) = delete;
+        logger& operator=(const logger&) = delete;
+
+        // Writes everything still queued. No thread may log concurrently.
+        ~logger() {
+            m_stopping.store(true, std::memory_order_release);
+            m_wake.notify_one();
+            m_writer.join();
+
+            for (auto& ring : m_rings) {
+                ring->closed.store(true, std::memory_order_release);
+            }
+        }
+
+        // Queues pattern with its "{}" placeholders replaced by args. Strings
+        // are copied (truncated to the record), other arguments must be
+        // trivially copyable. Returns false when the record was dropped.
+        template<typename... t_arguments>
+        bool write(log_pattern pattern, const t_arguments&... args) noexcept {
+            log_ring* ring = ring_for_this_thread();
+            if (ring == nullptr) {
+                m_unattached_drops.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            log_record* record = ring->reserve();
+            while (record == nullptr) {
+                if (m_options.policy == overflow_policy::drop) {
+                    ring->count_drop();
+                    return false;
+                }
+
+                m_wake.notify_one();
+                std::this_thread::yield();
+                record = ring->reserve();
+            }
+
+            std::byte* position = record->payload;
+            std::uint16_t encoded{ 0 };
+            // Stops at the first argument that does not fit.
+            [[maybe_unused]] const bool complete = ((detail::encode(position, record->payload + log_record::payload_size, args) && ++encoded) && ...);
+
+            record->format = &detail::format_record<detail::log_stored_t<t_arguments>...>;
+            record->pattern = pattern.text();
+            record->length = static_cast<std::uint16_t>(position - record->payload);
+            record->arguments = encoded;
+            ring->publish();
+
+            return true;
+        }
+
+        // Blocks until every record queued before the call is written.
+        void flush() {
+            std::vector<std::pair<std::shared_ptr<log_ring>, std::size_t>> pending;
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                for (const auto& ring : m_rings) {
+                    pending.emplace_back(ring, ring->published());
+                }
+            }
+
+            for (const auto& [ring, target] : pending) {
+                while (ring->consumed() < target) {
+                    m_wake.notify_one();
+                    std::this_thread::sleep_for(std::chrono::microseconds{ 100 });
+                }
+            }
+        }
+
+        std::uint64_t dropped() const {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            std::uint64_t total = m_unattached_drops.load(std::memory_order_relaxed) + m_retired_drops;
+
+            for (const auto& ring : m_rings) {
+                total += ring->dropped();
+            }
+
+            return total;
+        }
+
+    private:
+        struct thread_rings {
+            std::vector<std::pair<std::uint64_t, std::shared_ptr<log_ring>>> entries;
+
+            ~thread_rings() {
+                for (auto& entry : entries) {
+                    entry.second->abandoned.store(true, std::memory_order_release);
+                }
+            }
+
+            static thread_rings& local() noexcept {
+                thread_local thread_rings rings;
+                return rings;
+            }
+        };
+
+        log_ring* ring_for_this_thread() noexcept {
+            auto& entries = thread_rings::local().entries;
+
+            for (const auto& entry : entries) {
+                if (entry.first == m_id) {
+                    return entry.second.get();
+                }
+            }
+
+            try {
+                std::erase_if(entries, [](const auto& entry) { return entry.second->closed.load(std::memory_order_acquire); });
+
+                auto ring = std::make_shared<log_ring>(m_options.records_per_thread);
+                {
+                    std::lock_guard<std::mutex> lock{ m_mutex };
+                    m_rings.push_back(ring);
+                }
+
+                entries.emplace_back(m_id, ring);
+                return ring.get();
+            } catch (...) {
+                return nullptr;
+            }
+        }
+
+        void run() {
+            std::vector<char> text(batch_records * max_line);
+            std::vector<std::shared_ptr<log_ring>> rings;
+
+            while (true) {
+                const bool stopping = m_stopping.load(std::memory_order_acquire);
+                {
+                    std::lock_guard<std::mutex> lock{ m_mutex };
+                    rings = m_rings;
+                }
+
+                std::size_t written{ 0 };
+                for (const auto& ring : rings) {
+                    written += drain(*ring, text);
+                }
+
+                retire_abandoned();
+
+                if (stopping && written == 0) {
+                    return;
+                }
+
+                if (written == 0) {
+                    std::unique_lock<std::mutex> lock{ m_mutex };
+                    m_wake.wait_for(lock, m_options.flush_interval, [this] { return m_stopping.load(std::memory_order_acquire); });
+                }
+            }
+        }
+
+        // Formats the ring's records batch by batch and frees their slots
+        // as soon as they are copied into text.
+        std::size_t drain(log_ring& ring, std::vector<char>& text) {
+            std::size_t total{ 0 };
+
+            while (std::size_t available = ring.readable()) {
+                const auto count = std::min(available, batch_records);
+                std::size_t lengths[batch_records];
+
+                for (std::size_t i = 0; i < count; ++i) {
+                    const log_record& record = ring.peek(i);
+                    char* const line = text.data() + i * max_line;
+                    char* out = line;
+
+                    record.format(record, out, line + max_line - 1);
+                    *out++ = '\n';
+                    lengths[i] = static_cast<std::size_t>(out - line);
+                }
+
+                ring.consume(count);
+                write_lines(text.data(), lengths, count);
+                total += count;
+            }
+
+            return total;
+        }
+
+        void write_lines(char* text, const std::size_t* lengths, std::size_t count) noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+            iovec vectors[batch_records];
+            for (std::size_t i = 0; i < count; ++i) {
+                vectors[i] = { text + i * max_line, lengths[i] };
+            }
+
+            iovec* current = vectors;
+            int remaining = static_cast<int>(count);
+
+            while (remaining > 0) {
+                const ssize_t result = ::writev(m_options.fd, current, remaining);
+                if (result < 0) {
+                    if (errno == EINTR) continue;
+                    return;
+                }
+
+                auto done = static_cast<std::size_t>(result);
+                while (remaining > 0 && done >= current->iov_len) {
+                    done -= current->iov_len;
+                    ++current;
+                    --remaining;
+                }
+
+                if (remaining > 0) {
+                    current->iov_base = static_cast<char*>(current->iov_base) + done;
+                    current->iov_len -= done;
+                }
+            }
+#else
+            std::FILE* stream = m_options.fd == 1 ? stdout : stderr;
+            for (std::size_t i = 0; i < count; ++i) {
+                std::fwrite(text + i * max_line, 1, lengths[i], stream);
+            }
+            std::fflush(stream);
+#endif
+        }
+
+        // Rings of exited threads are dropped once empty.
+        void retire_abandoned() {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+
+            std::erase_if(m_rings, [this](const std::shared_ptr<log_ring>& ring) {
+                if (!ring->abandoned.load(std::memory_order_acquire) || ring->readable() != 0) {
+                    return false;
+                }
+
+                m_retired_drops += ring->dropped();
+                return true;
+            });
+        }
+
+        static std::uint64_t next_id() noexcept {
+            static std::atomic<std::uint64_t> counter{ 0 };
+            return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+    private:
+        const logger_options m_options;
+        const std::uint64_t m_id;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::vector<std::shared_ptr<log_ring>> m_rings;
+        std::uint64_t m_retired_drops{ 0 };
+        std::atomic<std::uint64_t> m_unattached_drops{ 0 };
+        std::atomic<bool> m_stopping{ false };
+
+        std::thread m_writer;
+    };
+} }
+
+#endif
@@ -0,0 +1,570 @@
+#ifndef MRT_SYSTEM_MEMORY_HPP_
+#define MRT_SYSTEM_MEMORY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <string>
+#include <system_error>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mrt { namespace system {
+    // Monotonic arena: allocation bumps a pointer inside the current chunk,
+    // deallocation does nothing and memory comes back with rewind() or
+    // release(). Chunks grow geometrically from upstream. Not thread-safe;
+    // meant for one request or one thread at a time.
+    class arena_resource final : public std::pmr::memory_resource {
+    public:
+        explicit arena_resource(std::size_t initial_size = 4096,
+                                std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+            : m_upstream{ upstream }, m_next_size{ std::max<std::size_t>(initial_size, 64) } {}
+
+        arena_resource(const arena_resource&) = delete;
+        arena_resource& operator=(const arena_resource&) = delete;
+
+        ~arena_resource() override {
+            release();
+        }
+
+        // Returns every chunk to upstream.
+        void release() noexcept {
+            while (m_chunks != nullptr) {
+                chunk* next = m_chunks->next;
+                m_upstream->deallocate(m_chunks, m_chunks->size, alignof(chunk));
+                m_chunks = next;
+            }
+
+            m_current = m_end = nullptr;
+        }
+
+        // Keeps the largest chunk and starts over in it, so an arena reused
+        // across requests stops calling upstream once it has warmed up.
+        void rewind() noexcept {
+            chunk* largest{ nullptr };
+
+            while (m_chunks != nullptr) {
+                chunk* next = m_chunks->next;
+
+                if (largest == nullptr || m_chunks->size > largest->size) {
+                    if (largest != nullptr) {
+                        m_upstream->deallocate(largest, largest->size, alignof(chunk));
+                    }
+                    largest = m_chunks;
+                } else {
+                    m_upstream->deallocate(m_chunks, m_chunks->size, alignof(chunk));
+                }
+
+                m_chunks = next;
+            }
+
+            m_chunks = largest;
+            if (largest != nullptr) {
+                largest->next = nullptr;
+                m_current = reinterpret_cast<std::byte*>(largest + 1);
+                m_end = reinterpret_cast<std::byte*>(largest) + largest->size;
+            }
+        }
+
+        std::pmr::memory_resource* upstream() const noexcept {
+            return m_upstream;
+        }
+
+    private:
+        struct alignas(std::max_align_t) chunk {
+            chunk* next;
+            std::size_t size;
+        };
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            if (void* memory = bump(bytes, alignment)) {
+                return memory;
+            }
+
+            const std::size_t needed = sizeof(chunk) + bytes + alignment;
+            const std::size_t size = std::max(m_next_size, needed);
+
+            auto* fresh = static_cast<chunk*>(m_upstream->allocate(size, alignof(chunk)));
+            fresh->next = m_chunks;
+            fresh->size = size;
+            m_chunks = fresh;
+            m_current = reinterpret_cast<std::byte*>(fresh + 1);
+            m_end = reinterpret_cast<std::byte*>(fresh) + size;
+            m_next_size = size * 2;
+
+            return bump(bytes, alignment);
+        }
+
+        void do_deallocate(void*, std::size_t, std::size_t) override {
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        void* bump(std::size_t bytes, std::size_t alignment) noexcept {
+            if (m_current == nullptr) {
+                return nullptr;
+            }
+
+            void* position = m_current;
+            std::size_t space = static_cast<std::size_t>(m_end - m_current);
+
+            if (std::align(alignment, bytes, position, space) == nullptr) {
+                return nullptr;
+            }
+
+            m_current = static_cast<std::byte*>(position) + bytes;
+            return position;
+        }
+
+    private:
+        std::pmr::memory_resource* m_upstream;
+        std::size_t m_next_size;
+        chunk* m_chunks{ nullptr };
+        std::byte* m_current{ nullptr };
+        std::byte* m_end{ nullptr };
+    };
+
+    // Pool of fixed-size blocks, carved from chunks obtained from upstream.
+    // Each thread keeps a small cache of free blocks per pool, so most
+    // allocations and deallocations touch no shared state; the shared free
+    // list is refilled or drained in batches under a mutex. Requests larger
+    // than the block size, or more aligned than max_align_t, go to upstream.
+    class pool_resource final : public std::pmr::memory_resource {
+    public:
+        explicit pool_resource(std::size_t block_size, std::size_t blocks_per_chunk = 256,
+                               std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : m_state{ std::make_shared<shared_state>(round_block_size(block_size), std::max<std::size_t>(blocks_per_chunk, 1), upstream) } {}
+
+        pool_resource(const pool_resource&) = delete;
+        pool_resource& operator=(const pool_resource&) = delete;
+
+        ~pool_resource() override = default;
+
+        std::size_t block_size() const noexcept {
+            return m_state->block_size;
+        }
+
+        std::pmr::memory_resource* upstream() const noexcept {
+            return m_state->upstream;
+        }
+
+    private:
+        static constexpr std::size_t batch_size = 32;
+        static constexpr std::size_t cache_entries = 4;
+
+        struct free_block {
+            free_block* next;
+        };
+
+        static std::size_t round_block_size(std::size_t size) noexcept {
+            constexpr std::size_t alignment = alignof(std::max_align_t);
+            size = std::max(size, sizeof(free_block));
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        struct shared_state {
+            const std::size_t block_size;
+            const std::size_t blocks_per_chunk;
+            std::pmr::memory_resource* const upstream;
+            const std::uint64_t id;
+
+            std::mutex mutex;
+            free_block* free{ nullptr };
+            free_block* chunks{ nullptr };
+
+            shared_state(std::size_t block_size, std::size_t blocks_per_chunk, std::pmr::memory_resource* upstream) noexcept
+                : block_size{ block_size }, blocks_per_chunk{ blocks_per_chunk }, upstream{ upstream }, id{ next_id() } {}
+
+            ~shared_state() {
+                while (chunks != nullptr) {
+                    free_block* next = chunks->next;
+                    upstream->deallocate(chunks, chunk_bytes(), alignof(std::max_align_t));
+                    chunks = next;
+                }
+            }
+
+            // The first block of every chunk links the chunks together.
+            std::size_t chunk_bytes() const noexcept {
+                return block_size * (blocks_per_chunk + 1);
+            }
+
+            // Moves up to batch_size blocks into a caller's list.
+            std::size_t take(free_block*& head) {
+                std::lock_guard<std::mutex> lock{ mutex };
+
+                if (free == nullptr) {
+                    auto* memory = static_cast<std::byte*>(upstream->allocate(chunk_bytes(), alignof(std::max_align_t)));
+                    auto* chunk = reinterpret_cast<free_block*>(memory);
+                    chunk->next = chunks;
+                    chunks = chunk;
+
+                    for (std::size_t i = blocks_per_chunk; i > 0; --i) {
+                        auto* block = reinterpret_cast<free_block*>(memory + i * block_size);
+                        block->next = free;
+                        free = block;
+                    }
+                }
+
+                std::size_t count{ 0 };
+                while (free != nullptr && count < batch_size) {
+                    free_block* block = free;
+                    free = block->next;
+                    block->next = head;
+                    head = block;
+                    ++count;
+                }
+
+                return count;
+            }
+
+            void give(free_block* first, free_block* last) noexcept {
+                std::lock_guard<std::mutex> lock{ mutex };
+                last->next = free;
+                free = first;
+            }
+
+            static std::uint64_t next_id() noexcept {
+                static std::atomic<std::uint64_t> counter{ 0 };
+                return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+            }
+        };
+
+        // A thread's cached blocks for one pool. The weak reference is only
+        // locked to hand blocks back; a destroyed pool's blocks are dropped.
+        struct cache_entry {
+            std::uint64_t id{ 0 };
+            free_block* head{ nullptr };
+            std::size_t count{ 0 };
+            std::weak_ptr<shared_state> state;
+
+            void flush() noexcept {
+                if (auto owner = state.lock(); owner && head != nullptr) {
+                    free_block* last = head;
+                    while (last->next != nullptr) {
+                        last = last->next;
+                    }
+
+                    owner->give(head, last);
+                }
+
+                *this = cache_entry{};
+            }
+        };
+
+        struct thread_cache {
+            std::array<cache_entry, cache_entries> entries;
+            std::size_t victim{ 0 };
+
+            ~thread_cache() {
+                for (auto& entry : entries) {
+                    entry.flush();
+                }
+            }
+
+            static thread_cache& local() noexcept {
+                thread_local thread_cache cache;
+                return cache;
+            }
+        };
+
+        cache_entry& cache_for_this_thread() noexcept {
+            auto& cache = thread_cache::local();
+
+            for (auto& entry : cache.entries) {
+                if (entry.id == m_state->id) {
+                    return entry;
+                }
+            }
+
+            auto& entry = cache.entries[cache.victim];
+            cache.victim = (cache.victim + 1) % cache_entries;
+
+            entry.flush();
+            entry.id = m_state->id;
+            entry.state = m_state;
+            return entry;
+        }
+
+        bool is_pooled(std::size_t bytes, std::size_t alignment) const noexcept {
+            return bytes <= m_state->block_size && alignment <= alignof(std::max_align_t);
+        }
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            if (!is_pooled(bytes, alignment)) {
+                return m_state->upstream->allocate(bytes, alignment);
+            }
+
+            auto& entry = cache_for_this_thread();
+            if (entry.head == nullptr) {
+                entry.count += m_state->take(entry.head);
+            }
+
+            free_block* block = entry.head;
+            entry.head = block->next;
+            --entry.count;
+            return block;
+        }
+
+        void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override {
+            if (!is_pooled(bytes, alignment)) {
+                m_state->upstream->deallocate(memory, bytes, alignment);
+                return;
+            }
+
+            auto& entry = cache_for_this_thread();
+            auto* block = static_cast<free_block*>(memory);
+            block->next = entry.head;
+            entry.head = block;
+
+            // Hand a batch back once the cache holds two, so blocks freed by
+            // a consumer thread flow back to producers.
+            if (++entry.count >= 2 * batch_size) {
+                free_block* first = entry.head;
+                free_block* last = first;
+                for (std::size_t i = 1; i < batch_size; ++i) {
+                    last = last->next;
+                }
+
+                entry.head = last->next;
+                entry.count -= batch_size;
+                m_state->give(first, last);
+            }
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    private:
+        std::shared_ptr<shared_state> m_state;
+    };
+
+    enum class page_policy {
+        // Regular pages.
+        normal,
+        // 2 MiB aligned mapping advised with MADV_HUGEPAGE; the kernel backs
+        // it with huge pages when transparent huge pages are enabled.
+        transparent_huge,
+        // hugetlbfs pages (MAP_HUGETLB), falling back to transparent_huge
+        // when none are reserved.
+        explicit_huge
+    };
+
+    struct mapped_options {
+        page_policy pages{ page_policy::transparent_huge };
+        // NUMA node to bind the memory to with mbind, -1 for the default
+        // first-touch placement.
+        int node{ -1 };
+        // Fail the allocation, instead of leaving the default placement,
+        // when the node binding is refused.
+        bool strict_node{ false };
+        // Touch every page on allocation so the hot path takes no faults.
+        bool prefault{ true };
+    };
+
+    // Memory resource mapping every allocation on its own with mmap, for
+    // large long-lived buffers such as multi-gigabyte rings. Sizes are
+    // rounded up to the page size in use. Elsewhere than Linux it forwards
+    // to the default resource.
+    class mapped_resource final : public std::pmr::memory_resource {
+    public:
+        struct statistics {
+            std::size_t mappings;
+            std::size_t explicit_huge;
+            std::size_t node_bound;
+        };
+
+        explicit mapped_resource(mapped_options options = {}) noexcept : m_options{ options } {}
+
+        mapped_resource(const mapped_resource&) = delete;
+        mapped_resource& operator=(const mapped_resource&) = delete;
+
+        const mapped_options& options() const noexcept {
+            return m_options;
+        }
+
+        statistics stats() const noexcept {
+            return { m_mappings.load(std::memory_order_relaxed),
+                     m_explicit_huge.load(std::memory_order_relaxed),
+                     m_node_bound.load(std::memory_order_relaxed) };
+        }
+
+        // Size of a huge page, from /proc/meminfo (2 MiB when unknown).
+        static std::size_t huge_page_size() {
+            static const std::size_t size = [] {
+                std::ifstream meminfo{ "/proc/meminfo" };
+                std::string key;
+                std::size_t kilobytes{ 0 };
+
+                while (meminfo >> key) {
+                    if (key == "Hugepagesize:" && meminfo >> kilobytes) {
+                        return kilobytes * 1024;
+                    }
+                }
+
+                return std::size_t{ 2 * 1024 * 1024 };
+            }();
+
+            return size;
+        }
+
+    private:
+#if defined(__linux__)
+        std::size_t granularity() const {
+            return m_options.pages == page_policy::normal ? static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) : huge_page_size();
+        }
+
+        std::size_t mapping_size(std::size_t bytes) const {
+            const std::size_t unit = granularity();
+            return (std::max<std::size_t>(bytes, 1) + unit - 1) / unit * unit;
+        }
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            const std::size_t unit = granularity();
+            if (alignment > unit) {
+                throw std::bad_alloc{};
+            }
+
+            const std::size_t size = mapping_size(bytes);
+            void* memory = MAP_FAILED;
+
+            if (m_options.pages == page_policy::explicit_huge) {
+                memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (memory != MAP_FAILED) {
+                    m_explicit_huge.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            if (memory == MAP_FAILED) {
+                memory = map_aligned(size, unit);
+            }
+
+            try {
+                bind(memory, size);
+            } catch (...) {
+                ::munmap(memory, size);
+                throw;
+            }
+
+            if (m_options.prefault) {
+                prefault(memory, size);
+            }
+
+            m_mappings.fetch_add(1, std::memory_order_relaxed);
+            return memory;
+        }
+
+        void do_deallocate(void* memory, std::size_t bytes, std::size_t) override {
+            ::munmap(memory, mapping_size(bytes));
+        }
+
+        // Maps size bytes aligned on unit, so that transparent huge pages
+        // can back the whole range, and trims the excess.
+        void* map_aligned(std::size_t size, std::size_t unit) const {
+            const std::size_t padded = m_options.pages == page_policy::normal ? size : size + unit;
+            void* mapped = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (mapped == MAP_FAILED) {
+                throw std::bad_alloc{};
+            }
+
+            if (m_options.pages == page_policy::normal) {
+                return mapped;
+            }
+
+            const auto address = reinterpret_cast<std::uintptr_t>(mapped);
+            const auto aligned = (address + unit - 1) / unit * unit;
+            const std::size_t head = aligned - address;
+
+            if (head != 0) {
+                ::munmap(mapped, head);
+            }
+
+            ::munmap(reinterpret_cast<void*>(aligned + size), padded - head - size);
+
+            void* memory = reinterpret_cast<void*>(aligned);
+            ::madvise(memory, size, MADV_HUGEPAGE);
+            return memory;
+        }
+
+        void bind(void* memory, std::size_t size) {
+            if (m_options.node < 0) {
+                return;
+            }
+
+            constexpr std::size_t bits = 64 * sizeof(unsigned long) * 8;
+            unsigned long mask[bits / (sizeof(unsigned long) * 8)]{};
+            const auto node = static_cast<std::size_t>(m_options.node);
+
+            if (node + 1 < bits) {
+                mask[node / (sizeof(unsigned long) * 8)] = 1ul << (node % (sizeof(unsigned long) * 8));
+
+                if (::syscall(SYS_mbind, memory, size, MPOL_BIND, mask, bits, MPOL_MF_MOVE | MPOL_MF_STRICT) == 0) {
+                    m_node_bound.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            } else {
+                errno = EINVAL;
+            }
+
+            if (m_options.strict_node) {
+                throw std::system_error{ errno, std::generic_category(), "mbind" };
+            }
+        }
+
+        // MADV_POPULATE_WRITE faults the range in one call (Linux 5.14);
+        // older kernels get one write per base page.
+        static void prefault(void* memory, std::size_t size) noexcept {
+#if defined(MADV_POPULATE_WRITE)
+            if (::madvise(memory, size, MADV_POPULATE_WRITE) == 0) {
+                return;
+            }
+#endif
+            const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            auto* bytes = static_cast<volatile unsigned char*>(memory);
+
+            for (std::size_t offset = 0; offset < size; offset += page) {
+                bytes[offset] = 0;
+            }
+        }
+#else
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            m_mappings.fetch_add(1, std::memory_order_relaxed);
+            return std::pmr::get_default_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override {
+            std::pmr::get_default_resource()->deallocate(memory, bytes, alignment);
+        }
+#endif
+
+        // Any instance unmaps what another mapped with the same page size.
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            const auto* mapped = dynamic_cast<const mapped_resource*>(&other);
+            return mapped != nullptr && (mapped->m_options.pages == page_policy::normal) == (m_options.pages == page_policy::normal);
+        }
+
+    private:
+        const mapped_options m_options;
+        std::atomic<std::size_t> m_mappings{ 0 };
+        std::atomic<std::size_t> m_explicit_huge{ 0 };
+        std::atomic<std::size_t> m_node_bound{ 0 };
+    };
+} }
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef MRT_SYSTEM_RING_READER_HPP_
+#define MRT_SYSTEM_RING_READER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+#include "../containers/circular_list.hpp"
+
+// ring_reader reads POSIX file descriptors; elsewhere the header is empty.
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace mrt { namespace system {
+    struct ring_reader_options {
+        // Reads in flight per fill(); forced to 1 for pipes and sockets,
+        // whose reads cannot be ordered by offset.
+        unsigned queue_depth{ 4 };
+        std::size_t read_size{ 64 * 1024 };
+        // Falls back to preadv/readv when io_uring is unavailable.
+        bool use_io_uring{ true };
+    };
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+    namespace detail {
+        // Minimal io_uring over the raw syscalls: one submission batch at a
+        // time, completions reaped until the batch is done.
+        class io_ring {
+        public:
+            explicit io_ring(unsigned entries) noexcept {
+                io_uring_params params;
+                std::memset(&params, 0, sizeof(params));
+
+                const long fd = syscall(__NR_io_uring_setup, entries, &params);
+                if (fd < 0) {
+                    return;
+                }
+
+                m_fd = static_cast<int>(fd);
+                m_sq_size = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+                m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                m_single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+                if (m_single_mmap) {
+                    m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+                }
+
+                m_sq = map(m_sq_size, IORING_OFF_SQ_RING);
+                m_cq = m_single_mmap ? m_sq : map(m_cq_size, IORING_OFF_CQ_RING);
+                m_sqes = static_cast<io_uring_sqe*>(map(params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES));
+                m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+                if (m_sq == nullptr || m_cq == nullptr || m_sqes == nullptr) {
+                    release();
+                    return;
+                }
+
+                m_sq_tail = field(m_sq, params.sq_off.tail);
+                m_sq_mask = *field(m_sq, params.sq_off.ring_mask);
+                m_sq_array = field(m_sq, params.sq_off.array);
+                m_cq_head = field(m_cq, params.cq_off.head);
+                m_cq_tail = field(m_cq, params.cq_off.tail);
+                m_cq_mask = *field(m_cq, params.cq_off.ring_mask);
+                m_cqes = reinterpret_cast<io_uring_cqe*>(static_cast<char*>(m_cq) + params.cq_off.cqes);
+                m_entries = params.sq_entries;
+            }
+
+            io_ring(const io_ring&) = delete;
+            io_ring& operator=(const io_ring&) = delete;
+
+            ~io_ring() {
+                release();
+            }
+
+            bool valid() const noexcept {
+                return m_fd >= 0;
+            }
+
+            unsigned entries() const noexcept {
+                return m_entries;
+            }
+
+            void queue_readv(int fd, const iovec* vectors, unsigned count, std::uint64_t offset, std::uint64_t user_data) noexcept {
+                const std::uint32_t tail = *m_sq_tail;
+                const std::uint32_t index = tail & m_sq_mask;
+
+                io_uring_sqe& sqe = m_sqes[index];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = IORING_OP_READV;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<std::uint64_t>(vectors);
+                sqe.len = count;
+                sqe.off = offset;
+                sqe.user_data = user_data;
+
+                m_sq_array[index] = index;
+                std::atomic_ref<std::uint32_t>{ *m_sq_tail }.store(tail + 1, std::memory_order_release);
+                ++m_queued;
+            }
+
+            // Submits what was queued and calls complete(user_data, result)
+            // once per request.
+            template<typename t_complete>
+            void run(t_complete&& complete) {
+                unsigned outstanding = m_queued;
+                unsigned to_submit = m_queued;
+                m_queued = 0;
+
+                while (outstanding != 0) {
+                    const long entered = syscall(__NR_io_uring_enter, m_fd, to_submit, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+                    if (entered < 0) {
+                        if (errno == EINTR) continue;
+                        throw std::system_error{ errno, std::generic_category(), "io_uring_enter" };
+                    }
+
+                    to_submit -= std::min<unsigned>(to_submit, static_cast<unsigned>(entered));
+
+                    std::uint32_t head = *m_cq_head;
+                    const std::uint32_t tail = std::atomic_ref<std::uint32_t>{ *m_cq_tail }.load(std::memory_order_acquire);
+
+                    for (; head != tail; ++head) {
+                        const io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+                        complete(cqe.user_data, cqe.res);
+                        --outstanding;
+                    }
+
+                    std::atomic_ref<std::uint32_t>{ *m_cq_head }.store(head, std::memory_order_release);
+                }
+            }
+
+        private:
+            void* map(std::size_t size, off_t offset) noexcept {
+                void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+                return memory == MAP_FAILED ? nullptr : memory;
+            }
+
+            static std::uint32_t* field(void* ring, std::uint32_t offset) noexcept {
+                return reinterpret_cast<std::uint32_t*>(static_cast<char*>(ring) + offset);
+            }
+
+            void release() noexcept {
+                if (m_sqes != nullptr) ::munmap(m_sqes, m_sqes_size);
+                if (m_cq != nullptr && !m_single_mmap) ::munmap(m_cq, m_cq_size);
+                if (m_sq != nullptr) ::munmap(m_sq, m_sq_size);
+                if (m_fd >= 0) ::close(m_fd);
+
+                m_sqes = nullptr;
+                m_sq = m_cq = nullptr;
+                m_fd = -1;
+            }
+
+        private:
+            int m_fd{ -1 };
+            bool m_single_mmap{ false };
+            unsigned m_entries{ 0 };
+            unsigned m_queued{ 0 };
+
+            void* m_sq{ nullptr };
+            void* m_cq{ nullptr };
+            io_uring_sqe* m_sqes{ nullptr };
+            std::size_t m_sq_size{ 0 };
+            std::size_t m_cq_size{ 0 };
+            std::size_t m_sqes_size{ 0 };
+
+            std::uint32_t* m_sq_tail{ nullptr };
+            std::uint32_t m_sq_mask{ 0 };
+            std::uint32_t* m_sq_array{ nullptr };
+            std::uint32_t* m_cq_head{ nullptr };
+            std::uint32_t* m_cq_tail{ nullptr };
+            std::uint32_t m_cq_mask{ 0 };
+            io_uring_cqe* m_cqes{ nullptr };
+        };
+    }
+#endif
+
+    // Reads a file descriptor straight into the free space of a byte ring.
+    // Each fill() splits the free space in up to queue_depth reads, issues
+    // them as one io_uring batch (or one preadv/readv without io_uring) and
+    // commits the data in file order, so nothing is copied after the read.
+    // Regular files are read by offset from the given start; pipes and
+    // sockets from their current position. The descriptor stays owned by
+    // the caller.
+    class ring_reader {
+    public:
+        explicit ring_reader(int fd, ring_reader_options options = {}, off_t offset = 0)
+            : m_fd{ fd }, m_options{ options }, m_offset{ offset } {
+            m_stream = ::lseek(fd, 0, SEEK_CUR) < 0 && errno == ESPIPE;
+            if (m_stream || m_options.queue_depth == 0) {
+                m_options.queue_depth = 1;
+            }
+
+            m_options.read_size = std::max<std::size_t>(m_options.read_size, 1);
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+            if (m_options.use_io_uring) {
+                m_ring = std::make_unique<detail::io_ring>(m_options.queue_depth);
+
+                if (!m_ring->valid()) {
+                    m_ring.reset();
+                } else {
+                    m_options.queue_depth = std::min(m_options.queue_depth, m_ring->entries());
+                }
+            }
+#endif
+        }
+
+        ring_reader(const ring_reader&) = delete;
+        ring_reader& operator=(const ring_reader&) = delete;
+
+        // Appends up to queue_depth * read_size bytes to ring and returns how
+        // many; 0 when the ring is full or at end of file. Throws
+        // std::system_error when the first read fails.
+        std::size_t fill(containers::circular_list<std::byte>& ring) {
+            const auto free = ring.writable_segments();
+            const std::size_t wanted = std::min(free.size(), m_options.queue_depth * m_options.read_size);
+
+            if (wanted == 0 || m_eof) {
+                return 0;
+            }
+
+            const std::size_t committed = uses_io_uring() ? read_uring(free, wanted) : read_vectored(free, wanted);
+            ring.commit(committed);
+
+            if (!m_stream) {
+                m_offset += static_cast<off_t>(committed);
+            }
+
+            return committed;
+        }
+
+        bool uses_io_uring() const noexcept {
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+            return m_ring != nullptr;
+#else
+            return false;
+#endif
+        }
+
+        bool eof() const noexcept {
+            return m_eof;
+        }
+
+        off_t offset() const noexcept {
+            return m_offset;
+        }
+
+    private:
+        // A read of the ring's free space; it spans the wrap point with two
+        // vectors when needed.
+        struct request {
+            iovec vectors[2];
+            unsigned count;
+            std::size_t length;
+            long result;
+        };
+
+        void plan(const containers::segment_pair<std::byte>& free, std::size_t wanted) {
+            m_requests.clear();
+            std::size_t position{ 0 };
+
+            while (position < wanted) {
+                request current{};
+                current.length = std::min(m_options.read_size, wanted - position);
+
+                std::size_t placed{ 0 };
+                while (placed < current.length) {
+                    const std::size_t at = position + placed;
+                    const bool in_first = at < free.first.size();
+                    std::byte* base = in_first ? free.first.data() + at : free.second.data() + (at - free.first.size());
+                    const std::size_t room = in_first ? free.first.size() - at : free.size() - at;
+                    const std::size_t length = std::min(room, current.length - placed);
+
+                    current.vectors[current.count++] = { base, length };
+                    placed += length;
+                }
+
+                m_requests.push_back(current);
+                position += current.length;
+            }
+        }
+
+        // Commits requests in order and stops at the first short one: the
+        // data read after a gap cannot be committed.
+        std::size_t collect() {
+            std::size_t committed{ 0 };
+
+            for (const auto& current : m_requests) {
+                if (current.result < 0) {
+                    if (committed == 0 && current.result != -EAGAIN && current.result != -EINTR) {
+                        throw std::system_error{ static_cast<int>(-current.result), std::generic_category(), "ring_reader read" };
+                    }
+
+                    break;
+                }
+
+                committed += static_cast<std::size_t>(current.result);
+
+                if (current.result == 0 && committed == 0) {
+                    m_eof = true;
+                }
+
+                if (static_cast<std::size_t>(current.result) < current.length) {
+                    break;
+                }
+            }
+
+            return committed;
+        }
+
+        std::size_t read_uring(const containers::segment_pair<std::byte>& free, std::size_t wanted) {
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+            plan(free, wanted);
+            off_t offset = m_offset;
+
+            for (std::size_t i = 0; i < m_requests.size(); ++i) {
+                auto& current = m_requests[i];
+                m_ring->queue_readv(m_fd, current.vectors, current.count,
+                                    m_stream ? ~std::uint64_t{ 0 } : static_cast<std::uint64_t>(offset), i);
+                offset += static_cast<off_t>(current.length);
+            }
+
+            m_ring->run([this](std::uint64_t index, int result) {
+                m_requests[index].result = result;
+            });
+#endif
+            return collect();
+        }
+
+        // Without io_uring the whole batch is a single preadv (readv on
+        // streams) over the free space, which is at most two segments.
+        std::size_t read_vectored(const containers::segment_pair<std::byte>& free, std::size_t wanted) {
+            request whole{};
+            whole.length = wanted;
+            whole.vectors[whole.count++] = { free.first.data(), std::min(wanted, free.first.size()) };
+
+            if (wanted > free.first.size()) {
+                whole.vectors[whole.count++] = { free.second.data(), wanted - free.first.size() };
+            }
+
+            ssize_t result;
+            do {
+                result = m_stream ? ::readv(m_fd, whole.vectors, static_cast<int>(whole.count))
+                                  : ::preadv(m_fd, whole.vectors, static_cast<int>(whole.count), m_offset);
+            } while (result < 0 && errno == EINTR);
+
+            whole.result = result < 0 ? -errno : static_cast<long>(result);
+            m_requests.assign(1, whole);
+            return collect();
+        }
+
+    private:
+        int m_fd;
+        ring_reader_options m_options;
+        off_t m_offset;
+        bool m_stream{ false };
+        bool m_eof{ false };
+        std::vector<request> m_requests;
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+        std::unique_ptr<detail::io_ring> m_ring;
+#endif
+    };
+} }
+
+#endif
+
+#endif
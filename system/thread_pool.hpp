@@ -0,0 +1,476 @@
+#ifndef MRT_SYSTEM_THREAD_POOL_HPP_
+#define MRT_SYSTEM_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "topology.hpp"
+
+namespace mrt { namespace system {
+    namespace detail {
+        struct pool_task {
+            virtual ~pool_task() = default;
+            virtual void run() noexcept = 0;
+        };
+
+        template<typename t_function>
+        struct pool_task_for final : pool_task {
+            explicit pool_task_for(t_function&& function) : function{ std::move(function) } {}
+            void run() noexcept override { function(); }
+
+            t_function function;
+        };
+
+        template<typename t_function>
+        pool_task* make_pool_task(t_function&& function) {
+            return new pool_task_for<std::decay_t<t_function>>{ std::decay_t<t_function>{ std::forward<t_function>(function) } };
+        }
+
+        // Bounded Chase-Lev deque: the owning worker pushes and pops at the
+        // bottom, thieves take from the top.
+        class work_deque {
+        public:
+            explicit work_deque(std::size_t capacity)
+                : m_tasks(std::bit_ceil(std::max<std::size_t>(capacity, 2))), m_mask{ static_cast<std::int64_t>(m_tasks.size()) - 1 } {}
+
+            bool push(pool_task* task) noexcept {
+                const auto bottom = m_bottom.load(std::memory_order_relaxed);
+                const auto top = m_top.load(std::memory_order_acquire);
+
+                if (bottom - top > m_mask) {
+                    return false;
+                }
+
+                m_tasks[bottom & m_mask].store(task, std::memory_order_relaxed);
+                m_bottom.store(bottom + 1, std::memory_order_release);
+                return true;
+            }
+
+            pool_task* pop() noexcept {
+                const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+                m_bottom.store(bottom, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto top = m_top.load(std::memory_order_relaxed);
+
+                if (top > bottom) {
+                    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                pool_task* task = m_tasks[bottom & m_mask].load(std::memory_order_relaxed);
+                if (top == bottom) {
+                    // Last task: race the thieves for it.
+                    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                        task = nullptr;
+                    }
+
+                    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                }
+
+                return task;
+            }
+
+            pool_task* steal() noexcept {
+                auto top = m_top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const auto bottom = m_bottom.load(std::memory_order_acquire);
+
+                if (top >= bottom) {
+                    return nullptr;
+                }
+
+                pool_task* task = m_tasks[top & m_mask].load(std::memory_order_relaxed);
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return nullptr;
+                }
+
+                return task;
+            }
+
+            bool empty() const noexcept {
+                return m_top.load(std::memory_order_acquire) >= m_bottom.load(std::memory_order_acquire);
+            }
+
+        private:
+            std::vector<std::atomic<pool_task*>> m_tasks;
+            const std::int64_t m_mask;
+
+            alignas(hardware_destructive_interference_size) std::atomic<std::int64_t> m_top{ 0 };
+            alignas(hardware_destructive_interference_size) std::atomic<std::int64_t> m_bottom{ 0 };
+        };
+
+        // Futex on Linux, std::atomic::wait elsewhere.
+        inline void park(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept {
+#if defined(__linux__)
+            static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex needs a plain 32-bit word");
+            syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+            word.wait(expected, std::memory_order_acquire);
+#endif
+        }
+
+        inline void unpark(std::atomic<std::uint32_t>& word, int count) noexcept {
+#if defined(__linux__)
+            syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+            if (count == 1) word.notify_one();
+            else word.notify_all();
+#endif
+        }
+    }
+
+    struct thread_pool_options {
+        // 0 uses std::thread::hardware_concurrency().
+        std::size_t threads{ 0 };
+        // Pins worker i to the i-th cpu allowed for the creating thread.
+        bool pin{ false };
+        // Tasks a worker can queue locally before spilling to the shared queue.
+        std::size_t local_capacity{ 1024 };
+    };
+
+    // Work-stealing pool. Tasks submitted from a worker go to its own
+    // deque, others to a shared injection queue; idle workers steal from
+    // each other and sleep on a futex when nothing is left. Submitted tasks
+    // must not throw; parallel_for and parallel_reduce propagate the first
+    // exception of their body instead.
+    class thread_pool {
+    public:
+        explicit thread_pool(thread_pool_options options = {}) {
+            const std::size_t count = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+            const auto cpus = options.pin ? cpu_topology::allowed_cpus() : std::vector<int>{};
+
+            for (std::size_t i = 0; i < count; ++i) {
+                m_deques.push_back(std::make_unique<detail::work_deque>(options.local_capacity));
+            }
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+                m_workers.emplace_back([this, i, cpu] {
+                    if (cpu >= 0) {
+                        pin_current_thread(cpu);
+                    }
+
+                    work(i);
+                });
+            }
+        }
+
+        explicit thread_pool(std::size_t threads) : thread_pool{ thread_pool_options{ threads } } {}
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        // Runs every task already queued, and those they submit, then joins
+        // the workers.
+        ~thread_pool() {
+            m_stopping.store(true, std::memory_order_seq_cst);
+            m_epoch.fetch_add(1, std::memory_order_seq_cst);
+            detail::unpark(m_epoch, static_cast<int>(m_workers.size()));
+
+            for (auto& worker : m_workers) {
+                worker.join();
+            }
+        }
+
+        std::size_t size() const noexcept {
+            return m_workers.size();
+        }
+
+        template<typename t_function>
+        void submit(t_function&& function) {
+            enqueue(detail::make_pool_task(std::forward<t_function>(function)));
+            wake(1);
+        }
+
+        // Submits every callable of [first, last) with one lock of the
+        // shared queue and one wake-up.
+        template<typename t_iterator>
+        void submit(t_iterator first, t_iterator last) {
+            std::vector<detail::pool_task*> tasks;
+            for (; first != last; ++first) {
+                tasks.push_back(detail::make_pool_task(std::move(*first)));
+            }
+
+            submit_tasks(tasks);
+        }
+
+        // Calls body(i) for every i in [first, last), split in chunks of
+        // grain indices (0 picks about four chunks per worker). The calling
+        // thread runs tasks while it waits.
+        template<typename t_index, typename t_body>
+        void parallel_for(t_index first, t_index last, t_body&& body, t_index grain = 0) {
+            parallel_chunks(first, last, grain, [&body](t_index begin, t_index end, std::size_t) {
+                for (t_index i = begin; i < end; ++i) {
+                    body(i);
+                }
+            }, [](std::size_t) {});
+        }
+
+        // Folds map(i) over [first, last) with reduce, which must be
+        // associative; init is the identity of reduce. Chunks are combined
+        // in index order, so the result does not depend on scheduling.
+        template<typename t_index, typename t_value, typename t_map, typename t_reduce>
+        t_value parallel_reduce(t_index first, t_index last, t_value init, t_map&& map, t_reduce&& reduce, t_index grain = 0) {
+            // Wrapped so that vector<bool> cannot pack neighbouring chunks.
+            struct partial_slot {
+                t_value value;
+            };
+
+            std::vector<partial_slot> partials;
+
+            parallel_chunks(first, last, grain, [&](t_index begin, t_index end, std::size_t chunk) {
+                t_value partial = init;
+                for (t_index i = begin; i < end; ++i) {
+                    partial = reduce(std::move(partial), map(i));
+                }
+
+                partials[chunk].value = std::move(partial);
+            }, [&](std::size_t chunks) { partials.assign(chunks, partial_slot{ init }); });
+
+            t_value result = std::move(init);
+            for (auto& partial : partials) {
+                result = reduce(std::move(result), std::move(partial.value));
+            }
+
+            return result;
+        }
+
+    private:
+        struct worker_context {
+            thread_pool* pool{ nullptr };
+            std::size_t index{ 0 };
+        };
+
+        static worker_context& current() noexcept {
+            thread_local worker_context context;
+            return context;
+        }
+
+        // Runs chunk_body(begin, end, chunk) over the split range; prepare
+        // receives the number of chunks before any of them starts.
+        template<typename t_index, typename t_chunk, typename t_prepare>
+        void parallel_chunks(t_index first, t_index last, t_index grain, t_chunk&& chunk_body, t_prepare&& prepare) {
+            if (!(first < last)) {
+                prepare(0);
+                return;
+            }
+
+            const auto count = static_cast<std::size_t>(last - first);
+            auto step = static_cast<std::size_t>(grain);
+            if (step == 0) {
+                step = std::max<std::size_t>(1, count / (size() * 4));
+            }
+
+            const std::size_t chunks = (count + step - 1) / step;
+            prepare(chunks);
+
+            std::atomic<std::size_t> remaining{ chunks };
+            std::exception_ptr error;
+            std::mutex error_mutex;
+
+            std::vector<detail::pool_task*> tasks;
+            tasks.reserve(chunks);
+
+            for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                const auto begin = static_cast<t_index>(first + static_cast<t_index>(chunk * step));
+                const auto end = chunk + 1 == chunks ? last : static_cast<t_index>(begin + static_cast<t_index>(step));
+
+                tasks.push_back(detail::make_pool_task([&, begin, end, chunk] {
+                    try {
+                        chunk_body(begin, end, chunk);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock{ error_mutex };
+                        if (!error) error = std::current_exception();
+                    }
+
+                    remaining.fetch_sub(1, std::memory_order_release);
+                }));
+            }
+
+            submit_tasks(tasks);
+
+            while (remaining.load(std::memory_order_acquire) != 0) {
+                if (!run_one()) {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        void submit_tasks(const std::vector<detail::pool_task*>& tasks) {
+            auto& context = current();
+            m_pending.fetch_add(tasks.size(), std::memory_order_relaxed);
+
+            if (context.pool == this) {
+                for (auto* task : tasks) {
+                    push(task);
+                }
+            } else {
+                std::lock_guard<std::mutex> lock{ m_global_mutex };
+                m_global.insert(m_global.end(), tasks.begin(), tasks.end());
+                m_global_size.store(m_global.size(), std::memory_order_release);
+            }
+
+            wake(static_cast<int>(std::min(tasks.size(), m_deques.size())));
+        }
+
+        void enqueue(detail::pool_task* task) {
+            m_pending.fetch_add(1, std::memory_order_relaxed);
+            push(task);
+        }
+
+        void push(detail::pool_task* task) {
+            auto& context = current();
+
+            if (context.pool == this && m_deques[context.index]->push(task)) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock{ m_global_mutex };
+            m_global.push_back(task);
+            m_global_size.store(m_global.size(), std::memory_order_release);
+        }
+
+        // Pairs with the sleeper count increment in work(): either the
+        // sleeper sees the new task, or this sees the sleeper.
+        void wake(int count) noexcept {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (m_sleepers.load(std::memory_order_seq_cst) != 0) {
+                m_epoch.fetch_add(1, std::memory_order_seq_cst);
+                detail::unpark(m_epoch, count);
+            }
+        }
+
+        detail::pool_task* take_global() {
+            if (m_global_size.load(std::memory_order_acquire) == 0) {
+                return nullptr;
+            }
+
+            std::lock_guard<std::mutex> lock{ m_global_mutex };
+            if (m_global.empty()) {
+                return nullptr;
+            }
+
+            auto* task = m_global.front();
+            m_global.pop_front();
+            m_global_size.store(m_global.size(), std::memory_order_release);
+            return task;
+        }
+
+        detail::pool_task* find_task() {
+            auto& context = current();
+            const bool is_worker = context.pool == this;
+
+            if (is_worker) {
+                if (auto* task = m_deques[context.index]->pop()) {
+                    return task;
+                }
+            }
+
+            if (auto* task = take_global()) {
+                return task;
+            }
+
+            const std::size_t start = is_worker ? context.index + 1 : 0;
+            for (std::size_t i = 0; i < m_deques.size(); ++i) {
+                if (auto* task = m_deques[(start + i) % m_deques.size()]->steal()) {
+                    return task;
+                }
+            }
+
+            return nullptr;
+        }
+
+        bool has_work() const noexcept {
+            if (m_global_size.load(std::memory_order_acquire) != 0) {
+                return true;
+            }
+
+            return std::any_of(m_deques.begin(), m_deques.end(), [](const auto& deque) { return !deque->empty(); });
+        }
+
+        bool run_one() {
+            detail::pool_task* task = find_task();
+            if (task == nullptr) {
+                return false;
+            }
+
+            task->run();
+            delete task;
+
+            // The last task of a stopping pool releases the parked workers.
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1 && m_stopping.load(std::memory_order_seq_cst)) {
+                m_epoch.fetch_add(1, std::memory_order_seq_cst);
+                detail::unpark(m_epoch, static_cast<int>(m_deques.size()));
+            }
+
+            return true;
+        }
+
+        void work(std::size_t index) {
+            current() = { this, index };
+
+            while (true) {
+                if (run_one()) {
+                    continue;
+                }
+
+                const auto epoch = m_epoch.load(std::memory_order_seq_cst);
+                m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+
+                if (has_work()) {
+                    m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                // Running tasks may still submit more, so stopping waits for
+                // the pending count rather than for empty queues.
+                if (m_stopping.load(std::memory_order_seq_cst) && m_pending.load(std::memory_order_acquire) == 0) {
+                    m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                detail::park(m_epoch, epoch);
+                m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        std::vector<std::unique_ptr<detail::work_deque>> m_deques;
+
+        std::mutex m_global_mutex;
+        std::deque<detail::pool_task*> m_global;
+        std::atomic<std::size_t> m_global_size{ 0 };
+        std::atomic<std::size_t> m_pending{ 0 };
+
+        alignas(hardware_destructive_interference_size) std::atomic<std::uint32_t> m_epoch{ 0 };
+        std::atomic<std::uint32_t> m_sleepers{ 0 };
+        std::atomic<bool> m_stopping{ false };
+
+        std::vector<std::thread> m_workers;
+    };
+} }
+
+#endif
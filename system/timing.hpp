@@ -0,0 +1,332 @@
+#ifndef MRT_SYSTEM_TIMING_HPP_
+#define MRT_SYSTEM_TIMING_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "../containers/log_linear_buckets.hpp"
+
+namespace mrt { namespace system {
+    // Raw cycle counter: the TSC on x86, the virtual counter on aarch64 and
+    // steady_clock (clock_gettime(CLOCK_MONOTONIC) on Linux) elsewhere.
+    // The TSC is assumed invariant, as on every x86 CPU of the last decade.
+    class cycle_clock {
+    public:
+        static std::uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#elif defined(__aarch64__)
+            std::uint64_t value;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+#else
+            return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        // Measured once, on first use, against steady_clock.
+        static double nanoseconds_per_cycle() noexcept {
+            static const double ratio = calibrate();
+            return ratio;
+        }
+
+        static double to_nanoseconds(std::uint64_t cycles) noexcept {
+            return static_cast<double>(cycles) * nanoseconds_per_cycle();
+        }
+
+    private:
+        static double calibrate() noexcept {
+            using clock = std::chrono::steady_clock;
+
+            const auto start_time = clock::now();
+            const auto start_cycles = now();
+            auto end_time = start_time;
+
+            while (end_time - start_time < std::chrono::milliseconds{ 10 }) {
+                end_time = clock::now();
+            }
+
+            const auto end_cycles = now();
+            const auto elapsed = std::chrono::duration<double, std::nano>(end_time - start_time).count();
+
+            return end_cycles > start_cycles ? elapsed / static_cast<double>(end_cycles - start_cycles) : 1.0;
+        }
+    };
+
+    // Log-linear histogram with 16 sub-buckets per power of two, so a bucket
+    // spans at most 1/16 of its lower bound. Only the owning thread records;
+    // readers may load concurrently.
+    class latency_histogram : public containers::log_linear_buckets<std::uint64_t, 4> {
+    public:
+        void record(std::uint64_t value) noexcept {
+            increment(m_buckets[bucket_of(value)], 1);
+            increment(m_count, 1);
+            increment(m_total, value);
+
+            if (value > m_maximum.load(std::memory_order_relaxed)) {
+                m_maximum.store(value, std::memory_order_relaxed);
+            }
+        }
+
+        std::uint64_t count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+        std::uint64_t total() const noexcept { return m_total.load(std::memory_order_relaxed); }
+        std::uint64_t maximum() const noexcept { return m_maximum.load(std::memory_order_relaxed); }
+
+        std::uint64_t bucket(std::size_t index) const noexcept {
+            return m_buckets[index].load(std::memory_order_relaxed);
+        }
+
+    private:
+        // Single writer: a plain load and store instead of a locked add.
+        static void increment(std::atomic<std::uint64_t>& counter, std::uint64_t amount) noexcept {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucket_count> m_buckets{};
+        std::atomic<std::uint64_t> m_count{ 0 };
+        std::atomic<std::uint64_t> m_total{ 0 };
+        std::atomic<std::uint64_t> m_maximum{ 0 };
+
+    public:
+        std::atomic<bool> owned{ true };
+        latency_histogram* next{ nullptr };
+    };
+
+    struct probe_summary {
+        const char* name;
+        std::uint64_t count;
+        double mean_ns;
+        double p50_ns;
+        double p90_ns;
+        double p99_ns;
+        double p999_ns;
+        double max_ns;
+    };
+
+    // Named measurement point. Each thread records into its own histogram,
+    // so recording never contends; summary() merges them. Probes must
+    // outlive the threads that record into them: declare them static.
+    class probe {
+    public:
+        explicit probe(const char* name)
+            : m_name{ name }, m_id{ next_id().fetch_add(1, std::memory_order_relaxed) } {
+            std::lock_guard<std::mutex> lock{ registry_mutex() };
+            m_next = probes();
+            probes() = this;
+        }
+
+        probe(const probe&) = delete;
+        probe& operator=(const probe&) = delete;
+
+        ~probe() {
+            {
+                std::lock_guard<std::mutex> lock{ registry_mutex() };
+                probe** link = &probes();
+
+                while (*link != this) {
+                    link = &(*link)->m_next;
+                }
+
+                *link = m_next;
+            }
+
+            latency_histogram* histogram = m_histograms.load(std::memory_order_acquire);
+            while (histogram != nullptr) {
+                latency_histogram* next = histogram->next;
+                delete histogram;
+                histogram = next;
+            }
+        }
+
+        const char* name() const noexcept {
+            return m_name;
+        }
+
+        void record(std::uint64_t cycles) noexcept {
+            auto& histograms = thread_slots::local().histograms;
+
+            if (m_id < histograms.size() && histograms[m_id] != nullptr) {
+                histograms[m_id]->record(cycles);
+            } else {
+                attach(histograms)->record(cycles);
+            }
+        }
+
+        probe_summary summary() const noexcept {
+            std::array<std::uint64_t, latency_histogram::bucket_count> merged{};
+            probe_summary result{ m_name, 0, 0, 0, 0, 0, 0, 0 };
+            std::uint64_t total{ 0 };
+            std::uint64_t maximum{ 0 };
+
+            for (auto* histogram = m_histograms.load(std::memory_order_acquire); histogram != nullptr; histogram = histogram->next) {
+                for (std::size_t i = 0; i < merged.size(); ++i) {
+                    merged[i] += histogram->bucket(i);
+                }
+
+                total += histogram->total();
+                maximum = histogram->maximum() > maximum ? histogram->maximum() : maximum;
+            }
+
+            for (const auto bucket_count : merged) {
+                result.count += bucket_count;
+            }
+
+            if (result.count == 0) {
+                return result;
+            }
+
+            result.mean_ns = cycle_clock::to_nanoseconds(total) / static_cast<double>(result.count);
+            result.p50_ns = quantile(merged, result.count, 0.5);
+            result.p90_ns = quantile(merged, result.count, 0.9);
+            result.p99_ns = quantile(merged, result.count, 0.99);
+            result.p999_ns = quantile(merged, result.count, 0.999);
+            result.max_ns = cycle_clock::to_nanoseconds(maximum);
+
+            return result;
+        }
+
+        template<typename t_function>
+        static void for_each(t_function&& function) {
+            std::lock_guard<std::mutex> lock{ registry_mutex() };
+
+            for (const probe* current = probes(); current != nullptr; current = current->m_next) {
+                function(*current);
+            }
+        }
+
+    private:
+        // Per-thread table of histograms indexed by probe id. On thread exit
+        // the histograms are released for reuse by later threads; their
+        // counts stay in the probe.
+        struct thread_slots {
+            std::vector<latency_histogram*> histograms;
+
+            ~thread_slots() {
+                for (auto* histogram : histograms) {
+                    if (histogram != nullptr) {
+                        histogram->owned.store(false, std::memory_order_release);
+                    }
+                }
+            }
+
+            static thread_slots& local() noexcept {
+                thread_local thread_slots slots;
+                return slots;
+            }
+        };
+
+        latency_histogram* attach(std::vector<latency_histogram*>& histograms) noexcept {
+            latency_histogram* histogram = m_histograms.load(std::memory_order_acquire);
+
+            for (; histogram != nullptr; histogram = histogram->next) {
+                bool released{ false };
+                if (histogram->owned.compare_exchange_strong(released, true, std::memory_order_acquire)) {
+                    break;
+                }
+            }
+
+            if (histogram == nullptr) {
+                histogram = new latency_histogram;
+                histogram->next = m_histograms.load(std::memory_order_relaxed);
+                while (!m_histograms.compare_exchange_weak(histogram->next, histogram, std::memory_order_release, std::memory_order_relaxed)) {
+                }
+            }
+
+            if (histograms.size() <= m_id) {
+                histograms.resize(m_id + 1, nullptr);
+            }
+
+            histograms[m_id] = histogram;
+            return histogram;
+        }
+
+        static double quantile(const std::array<std::uint64_t, latency_histogram::bucket_count>& buckets,
+                               std::uint64_t count, double fraction) noexcept {
+            const auto rank = static_cast<std::uint64_t>(fraction * static_cast<double>(count - 1));
+            std::uint64_t seen{ 0 };
+
+            for (std::size_t i = 0; i < buckets.size(); ++i) {
+                seen += buckets[i];
+
+                if (seen > rank) {
+                    const double middle = static_cast<double>(latency_histogram::lower_bound_of(i))
+                                        + static_cast<double>(latency_histogram::width_of(i) - 1) / 2;
+                    return middle * cycle_clock::nanoseconds_per_cycle();
+                }
+            }
+
+            return 0;
+        }
+
+        // Registration is rare and off the hot path, a mutex is enough.
+        static std::mutex& registry_mutex() noexcept {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        static probe*& probes() noexcept {
+            static probe* first{ nullptr };
+            return first;
+        }
+
+        static std::atomic<std::size_t>& next_id() noexcept {
+            static std::atomic<std::size_t> id{ 0 };
+            return id;
+        }
+
+    private:
+        const char* m_name;
+        const std::size_t m_id;
+        std::atomic<latency_histogram*> m_histograms{ nullptr };
+        probe* m_next{ nullptr };
+    };
+
+    class scoped_timer {
+    public:
+        explicit scoped_timer(probe& target) noexcept : m_probe{ target }, m_start{ cycle_clock::now() } {}
+
+        scoped_timer(const scoped_timer&) = delete;
+        scoped_timer& operator=(const scoped_timer&) = delete;
+
+        ~scoped_timer() {
+            m_probe.record(cycle_clock::now() - m_start);
+        }
+
+    private:
+        probe& m_probe;
+        std::uint64_t m_start;
+    };
+
+    // One line per probe that recorded something, latencies in nanoseconds.
+    inline void report(std::ostream& out) {
+        probe::for_each([&out](const probe& current) {
+            const auto summary = current.summary();
+
+            if (summary.count == 0) {
+                return;
+            }
+
+            out << summary.name
+                << " count=" << summary.count
+                << " mean=" << summary.mean_ns
+                << " p50=" << summary.p50_ns
+                << " p90=" << summary.p90_ns
+                << " p99=" << summary.p99_ns
+                << " p999=" << summary.p999_ns
+                << " max=" << summary.max_ns << '\n';
+        });
+    }
+} }
+
+#endif
@@ -0,0 +1,305 @@
+#ifndef MRT_SYSTEM_TOPOLOGY_HPP_
+#define MRT_SYSTEM_TOPOLOGY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace mrt { namespace system {
+    // Compile-time fallbacks for the std:: interference sizes, which GCC
+    // warns about in headers because their value depends on -mtune. Pad
+    // data written by different threads to the destructive size; keep data
+    // read together within the constructive size.
+#if defined(__aarch64__) && defined(__APPLE__)
+    inline constexpr std::size_t hardware_destructive_interference_size = 128;
+    inline constexpr std::size_t hardware_constructive_interference_size = 128;
+#elif defined(__powerpc64__)
+    inline constexpr std::size_t hardware_destructive_interference_size = 128;
+    inline constexpr std::size_t hardware_constructive_interference_size = 128;
+#else
+    inline constexpr std::size_t hardware_destructive_interference_size = 64;
+    inline constexpr std::size_t hardware_constructive_interference_size = 64;
+#endif
+
+    // Parses the kernel cpu list format, e.g. "0-3,8,10-11".
+    inline std::vector<int> parse_cpu_list(std::string_view list) {
+        std::vector<int> cpus;
+
+        while (!list.empty()) {
+            const auto comma = list.find(',');
+            const auto range = list.substr(0, comma);
+            list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+            const auto dash = range.find('-');
+            try {
+                const int first = std::stoi(std::string{ range.substr(0, dash) });
+                const int last = dash == std::string_view::npos ? first : std::stoi(std::string{ range.substr(dash + 1) });
+
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            } catch (const std::exception&) {
+                // Blank or malformed entries (e.g. a trailing newline) are skipped.
+            }
+        }
+
+        return cpus;
+    }
+
+    struct cpu_info {
+        int id;
+        int core;
+        int package;
+        int node;
+        // Lowest cpu id sharing this cpu's last level cache.
+        int llc;
+        // Whether the calling thread's affinity mask allows this cpu.
+        bool allowed;
+    };
+
+    class cpu_topology {
+    public:
+        // Reads /sys/devices/system/cpu (or root, for tests). When sysfs is
+        // unavailable every hardware thread is reported as its own core on a
+        // single package, node and cache.
+        static cpu_topology discover(const std::filesystem::path& root = "/sys/devices/system/cpu") {
+            return discover(root, allowed_cpus());
+        }
+
+        // Same, with an explicit set of allowed cpus (empty allows all).
+        static cpu_topology discover(const std::filesystem::path& root, const std::vector<int>& allowed) {
+            cpu_topology topology;
+            auto online = parse_cpu_list(read_line(root / "online"));
+
+            if (online.empty()) {
+                const int count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+                for (int cpu = 0; cpu < count; ++cpu) {
+                    topology.m_cpus.push_back({ cpu, cpu, 0, 0, 0, is_allowed(allowed, cpu) });
+                }
+
+                return topology;
+            }
+
+            for (const int cpu : online) {
+                const auto directory = root / ("cpu" + std::to_string(cpu));
+                cpu_info info{ cpu, cpu, 0, 0, cpu, is_allowed(allowed, cpu) };
+
+                info.core = read_int(directory / "topology" / "core_id", cpu);
+                info.package = read_int(directory / "topology" / "physical_package_id", 0);
+                info.node = find_node(directory);
+                info.llc = find_llc(directory, cpu, topology.m_cache_line_size);
+
+                topology.m_cpus.push_back(info);
+            }
+
+            return topology;
+        }
+
+        const std::vector<cpu_info>& cpus() const noexcept {
+            return m_cpus;
+        }
+
+        const cpu_info* find(int cpu) const noexcept {
+            const auto it = std::find_if(m_cpus.begin(), m_cpus.end(), [cpu](const cpu_info& info) { return info.id == cpu; });
+            return it == m_cpus.end() ? nullptr : &*it;
+        }
+
+        // Coherency line size reported by the first cache level, or the
+        // compile-time fallback.
+        std::size_t cache_line_size() const noexcept {
+            return m_cache_line_size;
+        }
+
+        static bool smt_siblings(const cpu_info& a, const cpu_info& b) noexcept {
+            return a.id != b.id && a.package == b.package && a.core == b.core;
+        }
+
+        static bool share_llc(const cpu_info& a, const cpu_info& b) noexcept {
+            return a.llc == b.llc;
+        }
+
+        // Cpus the calling thread may run on; empty when unknown.
+        static std::vector<int> allowed_cpus() {
+            std::vector<int> cpus;
+#if defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+
+            if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                    if (CPU_ISSET(cpu, &set)) {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+#endif
+            return cpus;
+        }
+
+    private:
+        static std::string read_line(const std::filesystem::path& path) {
+            std::ifstream in{ path };
+            std::string line;
+            std::getline(in, line);
+            return line;
+        }
+
+        static int read_int(const std::filesystem::path& path, int fallback) {
+            try {
+                return std::stoi(read_line(path));
+            } catch (const std::exception&) {
+                return fallback;
+            }
+        }
+
+        static bool is_allowed(const std::vector<int>& allowed, int cpu) {
+            return allowed.empty() || std::find(allowed.begin(), allowed.end(), cpu) != allowed.end();
+        }
+
+        static int find_node(const std::filesystem::path& directory) {
+            std::error_code error;
+
+            for (const auto& entry : std::filesystem::directory_iterator{ directory, error }) {
+                const auto name = entry.path().filename().string();
+
+                if (name.size() > 4 && name.compare(0, 4, "node") == 0) {
+                    try {
+                        return std::stoi(name.substr(4));
+                    } catch (const std::exception&) {
+                    }
+                }
+            }
+
+            return 0;
+        }
+
+        static int find_llc(const std::filesystem::path& directory, int cpu, std::size_t& line_size) {
+            std::error_code error;
+            int best_level{ -1 };
+            int llc{ cpu };
+
+            for (const auto& entry : std::filesystem::directory_iterator{ directory / "cache", error }) {
+                if (entry.path().filename().string().compare(0, 5, "index") != 0) {
+                    continue;
+                }
+
+                const int level = read_int(entry.path() / "level", -1);
+                if (level == 1) {
+                    line_size = static_cast<std::size_t>(read_int(entry.path() / "coherency_line_size", static_cast<int>(line_size)));
+                }
+
+                const auto sharing = parse_cpu_list(read_line(entry.path() / "shared_cpu_list"));
+                if (level > best_level && !sharing.empty()) {
+                    best_level = level;
+                    llc = *std::min_element(sharing.begin(), sharing.end());
+                }
+            }
+
+            return llc;
+        }
+
+    private:
+        std::vector<cpu_info> m_cpus;
+        std::size_t m_cache_line_size{ hardware_destructive_interference_size };
+    };
+
+    // Affinity setters return false when the platform or the kernel refuses.
+
+    inline bool pin_current_thread(int cpu) noexcept {
+#if defined(__linux__)
+        if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    inline bool pin_thread(std::thread& thread, int cpu) noexcept {
+#if defined(__linux__)
+        if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+        (void)thread;
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    enum class pair_placement {
+        // Two hardware threads of one core: cheapest hand-off, but the
+        // threads compete for the core's execution units.
+        smt_siblings,
+        // Distinct cores behind the same last level cache: the usual best
+        // choice for a producer/consumer ring.
+        shared_cache,
+        // Distinct last level caches (or nodes): isolation over latency.
+        separate_cache
+    };
+
+    // Picks a (producer, consumer) cpu pair among the allowed cpus matching
+    // placement. Cpu 0 is avoided when another pair exists, as it usually
+    // handles most interrupts.
+    inline std::optional<std::pair<int, int>> producer_consumer_pair(const cpu_topology& topology,
+                                                                     pair_placement placement = pair_placement::shared_cache) {
+        std::optional<std::pair<int, int>> fallback;
+
+        for (const auto& producer : topology.cpus()) {
+            for (const auto& consumer : topology.cpus()) {
+                if (!producer.allowed || !consumer.allowed || producer.id >= consumer.id) {
+                    continue;
+                }
+
+                bool matches{ false };
+                switch (placement) {
+                case pair_placement::smt_siblings:
+                    matches = cpu_topology::smt_siblings(producer, consumer);
+                    break;
+                case pair_placement::shared_cache:
+                    matches = cpu_topology::share_llc(producer, consumer) && !cpu_topology::smt_siblings(producer, consumer);
+                    break;
+                case pair_placement::separate_cache:
+                    matches = !cpu_topology::share_llc(producer, consumer);
+                    break;
+                }
+
+                if (!matches) {
+                    continue;
+                }
+
+                if (producer.id != 0) {
+                    return std::make_pair(producer.id, consumer.id);
+                }
+
+                if (!fallback) {
+                    fallback = std::make_pair(producer.id, consumer.id);
+                }
+            }
+        }
+
+        return fallback;
+    }
+} }
+
+#endif
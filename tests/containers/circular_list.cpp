@@ -368,6 +368,77 @@ namespace {
 
         return true;
     }
+
+    bool test_moves() {
+        circular_list<int> initial(3);
+        initial.push(18);
+        initial.push(19);
+        initial.push(20);
+        initial.push(21);
+
+        circular_list<int> move_ctor{std::move(initial)};
+        if (!move_ctor.full() || move_ctor.front() != 21 || move_ctor.back() != 19) {
+            std::clog << "Move ctor doesn't keep the content." << std::endl;
+            return false;
+        }
+
+        circular_list<int> move_op(1);
+        move_op = std::move(move_ctor);
+
+        if (move_op.size() != 3 || move_op.front() != 21 || move_op.back() != 19) {
+            std::clog << "Move operator doesn't keep the content." << std::endl;
+            return false;
+        }
+
+        move_op.push(22);
+        if (move_op.size() != 3 || move_op.front() != 22 || move_op.back() != 20) {
+            std::clog << "Move operator doesn't keep the capacity." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_segments() {
+        circular_list<int> list(5);
+        list.push(1);
+        list.push(2);
+        list.push(3);
+        list.pop();
+        list.pop();
+
+        // Head is at slot 3 of 6, so the 4 free slots wrap after 3.
+        auto free = list.writable_segments();
+        if (free.size() != 4 || free.first.size() != 3 || free.second.size() != 1) {
+            std::clog << "Writable segments don't split at the wrap." << std::endl;
+            return false;
+        }
+
+        for (std::size_t i = 0; i < 3; ++i) {
+            free[i] = 4 + static_cast<int>(i);
+        }
+
+        list.commit(3);
+
+        if (list.size() != 4 || list.front() != 6 || list.back() != 3) {
+            std::clog << "Commit doesn't publish written slots." << std::endl;
+            return false;
+        }
+
+        auto used = list.readable_segments();
+        if (used.size() != 4 || used[0] != 3 || used[3] != 6) {
+            std::clog << "Readable segments aren't ordered oldest first." << std::endl;
+            return false;
+        }
+
+        list.consume(3);
+        if (list.size() != 1 || list.back() != 6) {
+            std::clog << "Consume doesn't pop the oldest elements." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
 }
 
 namespace mrt { namespace tests { namespace circular_list {
@@ -390,6 +461,8 @@ namespace mrt { namespace tests { namespace circular_list {
         success = success & test_reverse_iterator();
         success = success & test_range();
         success = success & test_copies();
+        success = success & test_moves();
+        success = success & test_segments();
 
         return success;
     }
@@ -0,0 +1,98 @@
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <tuple>
+#include "soa_circular_list.hpp"
+#include "../../containers/soa_circular_list.hpp"
+
+using namespace mrt::containers;
+
+namespace {
+    using records = soa_circular_list<std::uint64_t, std::uint32_t, double, std::uint8_t>;
+
+    bool test_push_and_access() {
+        records list(4);
+        list.push(std::uint64_t{ 100 }, 1u, 0.5, std::uint8_t{ 1 });
+        list.push(std::make_tuple(std::uint64_t{ 200 }, 2u, 1.5, std::uint8_t{ 0 }));
+
+        if (list.size() != 2 || std::get<1>(list.back()) != 1u || std::get<0>(list.front()) != 200) {
+            std::clog << "soa_circular_list does not store records." << std::endl;
+            return false;
+        }
+
+        std::get<2>(list[1]) = 4.0;
+        if (list.column<2>()[1] != 4.0) {
+            std::clog << "soa_circular_list rows do not refer to the columns." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_wrapping_columns() {
+        records list(5);
+
+        for (std::uint32_t i = 0; i < 8; ++i) {
+            list.push(std::uint64_t{ i } * 10, i, i * 1.0, std::uint8_t( i % 2 ));
+        }
+
+        // Holds 3..7: slots 3 and 4, then 0 to 2 after the wrap.
+        const auto ids = list.column<1>();
+        if (!list.full() || ids.first.size() != 2 || ids.second.size() != 3) {
+            std::clog << "soa_circular_list column does not split at the wrap." << std::endl;
+            return false;
+        }
+
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (ids[i] != 3 + i) {
+                std::clog << "soa_circular_list column is not ordered oldest first." << std::endl;
+                return false;
+            }
+        }
+
+        const auto values = list.column<2>();
+        const double sum = std::accumulate(values.first.begin(), values.first.end(), 0.0)
+                         + std::accumulate(values.second.begin(), values.second.end(), 0.0);
+
+        if (sum != 3.0 + 4.0 + 5.0 + 6.0 + 7.0) {
+            std::clog << "soa_circular_list column scan is wrong." << std::endl;
+            return false;
+        }
+
+        list.pop();
+        list.pop();
+        list.pop();
+
+        const auto timestamps = list.column<0>();
+        if (timestamps.size() != 2 || !timestamps.second.empty() || timestamps[0] != 60 || timestamps[1] != 70) {
+            std::clog << "soa_circular_list pop does not advance all columns." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_column_alignment() {
+        const records list(3);
+
+        if (reinterpret_cast<std::uintptr_t>(list.column<3>().first.data()) % records::column_alignment != 0) {
+            std::clog << "soa_circular_list column is not aligned." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace soa_circular_list {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_push_and_access();
+        success = success & test_wrapping_columns();
+        success = success & test_column_alignment();
+
+        return success;
+    }
+
+} } }
@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_CONTAINERS_SOA_CIRCULAR_LIST_HPP_
+#define MRT_TESTS_CONTAINERS_SOA_CIRCULAR_LIST_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace soa_circular_list {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "windowed_quantile.hpp"
+#include "../../containers/windowed_quantile.hpp"
+
+using namespace mrt::containers;
+
+namespace {
+    std::uint32_t exact_quantile(const std::deque<std::uint32_t>& window, double q) {
+        std::vector<std::uint32_t> values(window.begin(), window.end());
+        const auto rank = static_cast<std::size_t>(q * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+
+    bool test_buckets() {
+        using quantiles = windowed_quantile<std::uint32_t>;
+
+        for (std::uint32_t value : { 0u, 1u, 31u, 32u, 33u, 1000u, 65535u, 4000000000u, 4294967295u }) {
+            const auto bucket = quantiles::bucket_of(value);
+
+            if (bucket >= quantiles::bucket_count || value < quantiles::lower_bound_of(bucket)
+                || value - quantiles::lower_bound_of(bucket) >= quantiles::width_of(bucket)) {
+                std::clog << "windowed_quantile bucket math is wrong for " << value << "." << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool test_small_values_are_exact() {
+        windowed_quantile<std::uint32_t> quantiles(5);
+
+        for (std::uint32_t value : { 9u, 1u, 7u, 3u, 5u }) {
+            quantiles.push(value);
+        }
+
+        if (quantiles.quantile(0) != 1 || quantiles.quantile(0.5) != 5 || quantiles.quantile(1) != 9) {
+            std::clog << "windowed_quantile is not exact below 2^precision." << std::endl;
+            return false;
+        }
+
+        // Evicts 9 and 1, the two oldest values.
+        quantiles.push(2);
+        quantiles.push(4);
+
+        if (quantiles.size() != 5 || quantiles.quantile(0) != 2 || quantiles.quantile(1) != 7) {
+            std::clog << "windowed_quantile does not forget evicted values." << std::endl;
+            return false;
+        }
+
+        quantiles.pop();
+        quantiles.pop();
+
+        if (quantiles.size() != 3 || quantiles.quantile(0) != 2 || quantiles.quantile(1) != 5) {
+            std::clog << "windowed_quantile does not forget popped values." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_relative_error() {
+        std::mt19937 generator{ 7 };
+        std::lognormal_distribution<double> latency{ 10.0, 1.5 };
+
+        windowed_quantile<std::uint32_t> quantiles(1000);
+        std::deque<std::uint32_t> reference;
+        const double tolerance = 1.0 / windowed_quantile<std::uint32_t>::sub_buckets;
+
+        for (int i = 0; i < 20000; ++i) {
+            const auto value = static_cast<std::uint32_t>(std::min(latency(generator), 4e9));
+            quantiles.push(value);
+            reference.push_back(value);
+
+            if (reference.size() > 1000) {
+                reference.pop_front();
+            }
+
+            if (i % 997 != 0) {
+                continue;
+            }
+
+            for (double q : { 0.5, 0.99, 0.999 }) {
+                const double exact = exact_quantile(reference, q);
+                const double estimate = quantiles.quantile(q);
+
+                if (std::abs(estimate - exact) > exact * tolerance) {
+                    std::clog << "windowed_quantile p" << q << " is " << estimate << ", expected about " << exact << "." << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool test_move() {
+        windowed_quantile<std::uint32_t> quantiles(4);
+        for (std::uint32_t value : { 1u, 2u, 3u, 4u, 5u }) {
+            quantiles.push(value);
+        }
+
+        windowed_quantile<std::uint32_t> moved{ std::move(quantiles) };
+        if (moved.size() != 4 || moved.quantile(0.0) != 2 || moved.quantile(1.0) != 5) {
+            std::clog << "windowed_quantile loses its window on move." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace windowed_quantile {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_buckets();
+        success = success & test_small_values_are_exact();
+        success = success & test_relative_error();
+        success = success & test_move();
+
+        return success;
+    }
+
+} } }
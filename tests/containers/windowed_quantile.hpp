@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_CONTAINERS_WINDOWED_QUANTILE_HPP_
+#define MRT_TESTS_CONTAINERS_WINDOWED_QUANTILE_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace windowed_quantile {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
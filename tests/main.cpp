@@ -2,11 +2,39 @@
 
 #include "../system/sysutil.hpp"
 #include "types/bounded.hpp"
+#include "types/bounded_bulk.hpp"
+#include "types/bounded_charconv.hpp"
+#include "types/bounded_fixed.hpp"
+#include "types/bounded_map.hpp"
+#include "types/bounded_telemetry.hpp"
+#include "types/bounded_telemetry_hook.hpp"
 #include "containers/circular_list.hpp"
+#include "containers/soa_circular_list.hpp"
+#include "containers/windowed_quantile.hpp"
+#include "system/logging.hpp"
+#include "system/memory.hpp"
+#include "system/ring_reader.hpp"
+#include "system/thread_pool.hpp"
+#include "system/timing.hpp"
+#include "system/topology.hpp"
 
 int main() {
     bool success = mrt::tests::bounded::execute();
+    success = success & mrt::tests::bounded_bulk::execute();
+    success = success & mrt::tests::bounded_charconv::execute();
+    success = success & mrt::tests::bounded_fixed::execute();
+    success = success & mrt::tests::bounded_map::execute();
+    success = success & mrt::tests::bounded_telemetry::execute();
+    success = success & mrt::tests::bounded_telemetry_hook::execute();
     success = success & mrt::tests::circular_list::execute();
+    success = success & mrt::tests::soa_circular_list::execute();
+    success = success & mrt::tests::windowed_quantile::execute();
+    success = success & mrt::tests::logging::execute();
+    success = success & mrt::tests::memory::execute();
+    success = success & mrt::tests::ring_reader::execute();
+    success = success & mrt::tests::thread_pool::execute();
+    success = success & mrt::tests::timing::execute();
+    success = success & mrt::tests::topology::execute();
 
     std::cout << "Test result: " << success << std::endl;
     mrt::system::pause();
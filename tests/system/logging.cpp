@@ -0,0 +1,174 @@
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "logging.hpp"
+#include "../../system/logging.hpp"
+
+using namespace mrt::system;
+
+namespace {
+    // Temporary file the logger writes to, read back after flushing.
+    class capture {
+    public:
+        capture() : m_file{ std::tmpfile() } {}
+        ~capture() { std::fclose(m_file); }
+
+        int fd() const noexcept {
+            return fileno(m_file);
+        }
+
+        std::vector<std::string> lines() const {
+            std::string content;
+            char buffer[4096];
+
+            std::rewind(m_file);
+            while (const auto count = std::fread(buffer, 1, sizeof(buffer), m_file)) {
+                content.append(buffer, count);
+            }
+
+            std::vector<std::string> result;
+            std::istringstream in{ content };
+            for (std::string line; std::getline(in, line);) {
+                result.push_back(line);
+            }
+
+            return result;
+        }
+
+    private:
+        std::FILE* m_file;
+    };
+
+    bool test_formatting() {
+        capture output;
+        {
+            logger log{ { output.fd() } };
+            const std::string name{ "ring" };
+
+            log.write("plain");
+            log.write("{} + {} = {}", 1, -2, -1L);
+            log.write("{}: {} {} {}", name, 2.5, true, 'x');
+            log.write("{{}} {} {}", "literal");
+            log.write("extra", 42);
+            log.flush();
+        }
+
+        const std::vector<std::string> expected{
+            "plain",
+            "1 + -2 = -1",
+            "ring: 2.5 true x",
+            "{} literal {}",
+            "extra"
+        };
+
+        if (output.lines() != expected) {
+            std::clog << "logger does not format records." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_truncation() {
+        capture output;
+        {
+            logger log{ { output.fd() } };
+            log.write("{}|{}", std::string(1000, 'a'), 7);
+        }
+
+        const auto lines = output.lines();
+        if (lines.size() != 1 || lines[0].size() >= log_record::payload_size + 2 || lines[0].back() != '}') {
+            std::clog << "logger does not truncate oversized arguments." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_threads() {
+        capture output;
+        {
+            logger log{ { output.fd(), overflow_policy::block, 16 } };
+            std::vector<std::thread> workers;
+
+            for (int thread = 0; thread < 4; ++thread) {
+                workers.emplace_back([&log, thread] {
+                    for (int i = 0; i < 1000; ++i) {
+                        log.write("{} {}", thread, i);
+                    }
+                });
+            }
+
+            for (auto& worker : workers) {
+                worker.join();
+            }
+
+            if (log.dropped() != 0) {
+                std::clog << "logger dropped records under the block policy." << std::endl;
+                return false;
+            }
+        }
+
+        // Per thread, lines come out in call order.
+        int next[4]{};
+        const auto lines = output.lines();
+
+        for (const auto& line : lines) {
+            int thread{ -1 };
+            int i{ -1 };
+            std::istringstream{ line } >> thread >> i;
+
+            if (thread < 0 || thread >= 4 || next[thread] != i) {
+                std::clog << "logger reorders a thread's records." << std::endl;
+                return false;
+            }
+
+            ++next[thread];
+        }
+
+        if (lines.size() != 4000) {
+            std::clog << "logger lost records." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_drop_policy() {
+        capture output;
+        std::uint64_t dropped{ 0 };
+        {
+            logger log{ { output.fd(), overflow_policy::drop, 4, std::chrono::milliseconds{ 1000 } } };
+
+            for (int i = 0; i < 100; ++i) {
+                log.write("{}", i);
+            }
+
+            dropped = log.dropped();
+        }
+
+        if (dropped == 0 || output.lines().size() + dropped != 100) {
+            std::clog << "logger does not count dropped records." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace logging {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_formatting();
+        success = success & test_truncation();
+        success = success & test_threads();
+        success = success & test_drop_policy();
+
+        return success;
+    }
+
+} } }
@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_SYSTEM_LOGGING_HPP_
+#define MRT_TESTS_SYSTEM_LOGGING_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace logging {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
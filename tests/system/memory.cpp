@@ -0,0 +1,260 @@
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <set>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "memory.hpp"
+#include "../../containers/circular_list.hpp"
+#include "../../system/memory.hpp"
+
+using namespace mrt::system;
+
+namespace {
+    // Forwards to new/delete and counts calls, to see what reaches upstream.
+    class counting_resource : public std::pmr::memory_resource {
+    public:
+        std::size_t allocations{ 0 };
+        std::size_t deallocations{ 0 };
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override {
+            ++deallocations;
+            std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    bool test_arena_alignment() {
+        arena_resource arena{ 256 };
+
+        for (std::size_t alignment = 1; alignment <= 64; alignment *= 2) {
+            void* memory = arena.allocate(3, alignment);
+
+            if (reinterpret_cast<std::uintptr_t>(memory) % alignment != 0) {
+                std::clog << "arena_resource returned misaligned memory." << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool test_arena_rewind() {
+        counting_resource upstream;
+
+        {
+            arena_resource arena{ 128, &upstream };
+
+            for (int i = 0; i < 100; ++i) {
+                (void)arena.allocate(64, 8);
+            }
+
+            const auto grown = upstream.allocations;
+            arena.rewind();
+
+            if (upstream.deallocations != grown - 1) {
+                std::clog << "arena_resource::rewind does not keep one chunk." << std::endl;
+                return false;
+            }
+
+            // The kept chunk is the largest, which holds more than a round.
+            for (int i = 0; i < 50; ++i) {
+                (void)arena.allocate(64, 8);
+            }
+
+            if (upstream.allocations != grown) {
+                std::clog << "arena_resource does not reuse its chunk after rewind." << std::endl;
+                return false;
+            }
+        }
+
+        if (upstream.allocations != upstream.deallocations) {
+            std::clog << "arena_resource leaks chunks." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_pool_reuse() {
+        counting_resource upstream;
+
+        {
+            pool_resource pool{ 24, 64, &upstream };
+            std::vector<void*> blocks;
+
+            for (int round = 0; round < 10; ++round) {
+                for (int i = 0; i < 100; ++i) {
+                    blocks.push_back(pool.allocate(24, 8));
+                }
+
+                for (void* block : blocks) {
+                    pool.deallocate(block, 24, 8);
+                }
+
+                blocks.clear();
+            }
+
+            if (upstream.allocations != 2) {
+                std::clog << "pool_resource does not reuse its blocks." << std::endl;
+                return false;
+            }
+
+            void* large = pool.allocate(1024, 8);
+            pool.deallocate(large, 1024, 8);
+
+            if (upstream.allocations != 3 || upstream.deallocations != 1) {
+                std::clog << "pool_resource does not forward large requests." << std::endl;
+                return false;
+            }
+        }
+
+        if (upstream.allocations != upstream.deallocations) {
+            std::clog << "pool_resource leaks chunks." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_pool_threads() {
+        pool_resource pool{ 32 };
+        std::vector<std::vector<void*>> taken(4);
+        std::vector<std::thread> workers;
+
+        for (auto& blocks : taken) {
+            workers.emplace_back([&pool, &blocks] {
+                for (int i = 0; i < 1000; ++i) {
+                    blocks.push_back(pool.allocate(32, 16));
+                }
+
+                // Give half back from this thread; the rest is freed below.
+                for (int i = 0; i < 500; ++i) {
+                    pool.deallocate(blocks.back(), 32, 16);
+                    blocks.pop_back();
+                }
+            });
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        std::set<void*> unique;
+        for (const auto& blocks : taken) {
+            unique.insert(blocks.begin(), blocks.end());
+        }
+
+        if (unique.size() != 2000) {
+            std::clog << "pool_resource handed one block to two threads." << std::endl;
+            return false;
+        }
+
+        for (const auto& blocks : taken) {
+            for (void* block : blocks) {
+                pool.deallocate(block, 32, 16);
+            }
+        }
+
+        return true;
+    }
+
+    bool test_circular_list_resource() {
+        counting_resource upstream;
+
+        {
+            arena_resource arena{ 4096, &upstream };
+            mrt::containers::circular_list<int> list(8, &arena);
+
+            for (int i = 0; i < 20; ++i) {
+                list.push(i);
+            }
+
+            mrt::containers::circular_list<int> moved{ std::move(list) };
+
+            if (moved.get_resource() != &arena || moved.size() != 8 || moved.front() != 19 || moved.back() != 12) {
+                std::clog << "circular_list does not keep its resource and content on move." << std::endl;
+                return false;
+            }
+        }
+
+        if (upstream.allocations != 1 || upstream.deallocations != 1) {
+            std::clog << "circular_list does not allocate from its resource." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_mapped_resource() {
+        mapped_resource resource{ mapped_options{ page_policy::transparent_huge, 0 } };
+        const std::size_t size = 3 * 1024 * 1024;
+
+        auto* bytes = static_cast<unsigned char*>(resource.allocate(size, 64));
+        bytes[0] = 1;
+        bytes[size - 1] = 2;
+
+        const bool aligned = reinterpret_cast<std::uintptr_t>(bytes) % mapped_resource::huge_page_size() == 0;
+        resource.deallocate(bytes, size, 64);
+
+        if (!aligned || resource.stats().mappings != 1) {
+            std::clog << "mapped_resource does not align huge page mappings." << std::endl;
+            return false;
+        }
+
+        // Binding may be refused in a container; strict mode must then throw.
+        mapped_resource strict{ mapped_options{ page_policy::normal, 100000, true } };
+        try {
+            strict.deallocate(strict.allocate(4096, 8), 4096, 8);
+            std::clog << "mapped_resource ignores a refused strict binding." << std::endl;
+            return false;
+        } catch (const std::system_error&) {
+        }
+
+        return true;
+    }
+
+    bool test_mapped_circular_list() {
+        mapped_resource resource{ mapped_options{ page_policy::explicit_huge } };
+        mrt::containers::circular_list<std::uint64_t> ring(1 << 20, &resource);
+
+        for (std::uint64_t i = 0; i < 3 * (1 << 19); ++i) {
+            ring.push(i);
+        }
+
+        if (ring.size() != 1 << 20 || ring.front() != 3 * (1 << 19) - 1 || ring.back() != 3 * (1 << 19) - (1 << 20)) {
+            std::clog << "circular_list does not work on mapped memory." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace memory {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_arena_alignment();
+        success = success & test_arena_rewind();
+        success = success & test_pool_reuse();
+        success = success & test_pool_threads();
+        success = success & test_circular_list_resource();
+        success = success & test_mapped_resource();
+        success = success & test_mapped_circular_list();
+
+        return success;
+    }
+
+} } }
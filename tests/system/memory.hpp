@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_SYSTEM_MEMORY_HPP_
+#define MRT_TESTS_SYSTEM_MEMORY_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace memory {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
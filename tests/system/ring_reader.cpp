@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "ring_reader.hpp"
+#include "../../system/ring_reader.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace mrt::system;
+using mrt::containers::circular_list;
+
+namespace {
+    std::byte expected_byte(std::size_t position) {
+        return static_cast<std::byte>((position * 31 + position / 251) & 0xff);
+    }
+
+    std::filesystem::path make_file(std::size_t size) {
+        const auto path = std::filesystem::temp_directory_path() / "mrt_ring_reader_test";
+        std::ofstream out{ path, std::ios::binary };
+
+        for (std::size_t i = 0; i < size; ++i) {
+            out.put(static_cast<char>(expected_byte(i)));
+        }
+
+        return path;
+    }
+
+    // Reads the whole descriptor through a small ring, consuming an uneven
+    // amount after every fill so reads keep landing across the wrap.
+    bool drain(int fd, ring_reader_options options, std::size_t size, bool require_io_uring, const char* name) {
+        ring_reader reader{ fd, options };
+        circular_list<std::byte> ring(10000);
+        std::size_t position{ 0 };
+
+        if (require_io_uring && !reader.uses_io_uring()) {
+            return true; // io_uring unavailable here, nothing to check.
+        }
+
+        while (!reader.eof() || !ring.empty()) {
+            reader.fill(ring);
+
+            auto used = ring.readable_segments();
+            const std::size_t take = std::min<std::size_t>(used.size(), 7777);
+
+            for (std::size_t i = 0; i < take; ++i) {
+                if (used[i] != expected_byte(position + i)) {
+                    std::clog << name << " corrupts data at " << position + i << "." << std::endl;
+                    return false;
+                }
+            }
+
+            ring.consume(take);
+            position += take;
+        }
+
+        if (position != size) {
+            std::clog << name << " read " << position << " bytes instead of " << size << "." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_file(bool use_io_uring, const char* name) {
+        constexpr std::size_t size = 300001;
+        const auto path = make_file(size);
+        const int fd = ::open(path.c_str(), O_RDONLY);
+
+        ring_reader_options options;
+        options.queue_depth = 4;
+        options.read_size = 1000;
+        options.use_io_uring = use_io_uring;
+
+        const bool success = drain(fd, options, size, use_io_uring, name);
+
+        ::close(fd);
+        std::filesystem::remove(path);
+        return success;
+    }
+
+    bool test_pipe() {
+        int fds[2];
+        if (::pipe(fds) != 0) {
+            return true;
+        }
+
+        constexpr std::size_t size = 50000;
+        std::vector<std::byte> data(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = expected_byte(i);
+        }
+
+        std::thread writer{ [&] {
+            std::size_t written{ 0 };
+            while (written < size) {
+                const auto result = ::write(fds[1], data.data() + written, size - written);
+                if (result <= 0) break;
+                written += static_cast<std::size_t>(result);
+            }
+
+            ::close(fds[1]);
+        } };
+
+        const bool success = drain(fds[0], ring_reader_options{}, size, false, "ring_reader on a pipe");
+
+        writer.join();
+        ::close(fds[0]);
+        return success;
+    }
+
+    bool test_read_error() {
+        circular_list<std::byte> ring(16);
+        ring_reader reader{ -1, ring_reader_options{ 1, 16, false } };
+
+        try {
+            reader.fill(ring);
+        } catch (const std::system_error&) {
+            return true;
+        }
+
+        std::clog << "ring_reader does not report read errors." << std::endl;
+        return false;
+    }
+}
+
+#endif
+
+namespace mrt { namespace tests { namespace ring_reader {
+
+    bool execute() noexcept {
+        bool success{ true };
+#if defined(__unix__) || defined(__APPLE__)
+        success = success & test_file(true, "ring_reader with io_uring");
+        success = success & test_file(false, "ring_reader with preadv");
+        success = success & test_pipe();
+        success = success & test_read_error();
+#endif
+
+        return success;
+    }
+
+} } }
@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_SYSTEM_RING_READER_HPP_
+#define MRT_TESTS_SYSTEM_RING_READER_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace ring_reader {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
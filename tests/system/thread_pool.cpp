@@ -0,0 +1,199 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "thread_pool.hpp"
+#include "../../system/thread_pool.hpp"
+
+using namespace mrt::system;
+
+namespace {
+    bool test_submit() {
+        std::atomic<int> done{ 0 };
+        {
+            mrt::system::thread_pool pool{ 4 };
+
+            for (int i = 0; i < 1000; ++i) {
+                pool.submit([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+            }
+        }
+
+        if (done.load() != 1000) {
+            std::clog << "thread_pool does not run every submitted task." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_bulk_submit_and_nesting() {
+        std::atomic<int> done{ 0 };
+        {
+            mrt::system::thread_pool pool{ thread_pool_options{ 3, false, 4 } };
+            std::vector<std::function<void()>> batch;
+
+            // Each task spawns more than a local deque holds, so tasks also
+            // spill to the shared queue.
+            for (int i = 0; i < 10; ++i) {
+                batch.emplace_back([&pool, &done] {
+                    for (int j = 0; j < 20; ++j) {
+                        pool.submit([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+                    }
+                });
+            }
+
+            pool.submit(batch.begin(), batch.end());
+        }
+
+        if (done.load() != 200) {
+            std::clog << "thread_pool loses tasks submitted from workers." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_parallel_for() {
+        mrt::system::thread_pool pool{ 4 };
+        std::vector<int> values(10007, 0);
+
+        pool.parallel_for(std::size_t{ 0 }, values.size(), [&values](std::size_t i) { values[i] += static_cast<int>(i); });
+
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (values[i] != static_cast<int>(i)) {
+                std::clog << "parallel_for does not visit every index once." << std::endl;
+                return false;
+            }
+        }
+
+        bool visited{ false };
+        pool.parallel_for(5, 5, [&visited](int) { visited = true; });
+
+        if (visited) {
+            std::clog << "parallel_for visits an empty range." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_parallel_reduce() {
+        mrt::system::thread_pool pool{ 4 };
+
+        const auto sum = pool.parallel_reduce(std::int64_t{ 1 }, std::int64_t{ 100001 }, std::int64_t{ 0 },
+                                              [](std::int64_t i) { return i; },
+                                              [](std::int64_t a, std::int64_t b) { return a + b; }, std::int64_t{ 1000 });
+
+        // Concatenation is not commutative: checks the chunk order.
+        const auto text = pool.parallel_reduce(0, 26, std::string{},
+                                               [](int i) { return std::string(1, static_cast<char>('a' + i)); },
+                                               [](std::string a, const std::string& b) { return a + b; }, 3);
+
+        if (sum != 5000050000 || text != "abcdefghijklmnopqrstuvwxyz") {
+            std::clog << "parallel_reduce does not fold in order." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_parallel_for_exception() {
+        mrt::system::thread_pool pool{ 2 };
+
+        try {
+            pool.parallel_for(0, 100, [](int i) {
+                if (i == 42) throw std::runtime_error("body");
+            }, 1);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+
+        std::clog << "parallel_for does not propagate exceptions." << std::endl;
+        return false;
+    }
+
+    bool test_parking() {
+        mrt::system::thread_pool pool{ 2 };
+        std::atomic<int> done{ 0 };
+
+        // Let the workers park, then make sure a submit wakes one up.
+        for (int round = 0; round < 3; ++round) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+            pool.submit([&done] { done.fetch_add(1); });
+
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+            while (done.load() != round + 1 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (done.load() != 3) {
+            std::clog << "thread_pool does not wake parked workers." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_blocking_tasks_overlap() {
+        constexpr int tasks = 4;
+        std::atomic<int> started{ 0 };
+        std::atomic<int> overlapped{ 0 };
+        std::atomic<int> finished{ 0 };
+        {
+            mrt::system::thread_pool pool{ tasks };
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+
+            // Each task blocks until every task has started, so they only
+            // all finish if the pool runs them at the same time.
+            for (int i = 0; i < tasks; ++i) {
+                pool.submit([&started, &overlapped, &finished] {
+                    started.fetch_add(1);
+
+                    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+                    while (started.load() != tasks && std::chrono::steady_clock::now() < deadline) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+                    }
+
+                    if (started.load() == tasks) {
+                        overlapped.fetch_add(1);
+                    }
+
+                    finished.fetch_add(1);
+                });
+            }
+
+            // Wait here: the destructor would wake every worker anyway.
+            while (finished.load() != tasks) {
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+            }
+        }
+
+        if (overlapped.load() != tasks) {
+            std::clog << "thread_pool does not run blocking tasks concurrently." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace thread_pool {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_submit();
+        success = success & test_bulk_submit_and_nesting();
+        success = success & test_parallel_for();
+        success = success & test_parallel_reduce();
+        success = success & test_parallel_for_exception();
+        success = success & test_parking();
+        success = success & test_blocking_tasks_overlap();
+
+        return success;
+    }
+
+} } }
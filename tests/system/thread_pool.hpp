@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_SYSTEM_THREAD_POOL_HPP_
+#define MRT_TESTS_SYSTEM_THREAD_POOL_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace thread_pool {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
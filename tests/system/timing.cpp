@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "timing.hpp"
+#include "../../system/timing.hpp"
+
+using namespace mrt::system;
+
+namespace {
+    probe scoped_probe{ "tests.scoped" };
+    probe threaded_probe{ "tests.threaded" };
+
+    bool test_histogram_buckets() {
+        const std::uint64_t values[] = { 0, 1, 15, 16, 17, 31, 32, 33, 1000, 123456789, ~std::uint64_t{ 0 } };
+
+        for (const auto value : values) {
+            const auto bucket = latency_histogram::bucket_of(value);
+            const auto lower = latency_histogram::lower_bound_of(bucket);
+
+            if (bucket >= latency_histogram::bucket_count || value < lower || value - lower >= latency_histogram::width_of(bucket)) {
+                std::clog << "latency_histogram puts " << value << " in the wrong bucket." << std::endl;
+                return false;
+            }
+
+            if (value >= 16 && latency_histogram::width_of(bucket) * 16 > lower) {
+                std::clog << "latency_histogram bucket for " << value << " is too wide." << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool test_cycle_clock() {
+        const auto start = cycle_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 2 });
+        const auto elapsed = cycle_clock::to_nanoseconds(cycle_clock::now() - start);
+
+        if (elapsed < 1e6 || elapsed > 1e9) {
+            std::clog << "cycle_clock calibration is off: 2ms measured as " << elapsed << "ns" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_scoped_timer() {
+        for (int i = 0; i < 100; ++i) {
+            scoped_timer timer{ scoped_probe };
+        }
+
+        const auto summary = scoped_probe.summary();
+        if (summary.count != 100 || summary.p50_ns > summary.max_ns * 1.07 || summary.p50_ns > summary.p99_ns) {
+            std::clog << "scoped_timer summary is incorrect." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_threaded_recording() {
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([] {
+                for (std::uint64_t i = 0; i < 1000; ++i) {
+                    threaded_probe.record(i);
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Histograms of exited threads are reused, not duplicated.
+        std::thread{ [] { threaded_probe.record(5); } }.join();
+
+        if (threaded_probe.summary().count != 4001) {
+            std::clog << "probe lost records from threads: " << threaded_probe.summary().count << std::endl;
+            return false;
+        }
+
+        std::ostringstream out;
+        report(out);
+        if (out.str().find("tests.threaded count=4001") == std::string::npos) {
+            std::clog << "report is missing a probe: " << out.str() << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace timing {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_histogram_buckets();
+        success = success & test_cycle_clock();
+        success = success & test_scoped_timer();
+        success = success & test_threaded_recording();
+
+        return success;
+    }
+
+} } }
@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_SYSTEM_TIMING_HPP_
+#define MRT_TESTS_SYSTEM_TIMING_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace timing {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
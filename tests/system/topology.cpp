@@ -0,0 +1,137 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "topology.hpp"
+#include "../../system/topology.hpp"
+
+using namespace mrt::system;
+
+namespace {
+    void write_file(const std::filesystem::path& path, const std::string& content) {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream{ path } << content << '\n';
+    }
+
+    // Two packages, each with two cores of two hardware threads sharing
+    // one L3: cpus 0-3 on package 0 and 4-7 on package 1, siblings n/n+2.
+    std::filesystem::path make_fake_sysfs() {
+        const auto root = std::filesystem::temp_directory_path() / "mrt_topology_test";
+        std::filesystem::remove_all(root);
+        write_file(root / "online", "0-7");
+
+        for (int cpu = 0; cpu < 8; ++cpu) {
+            const auto directory = root / ("cpu" + std::to_string(cpu));
+            const int package = cpu / 4;
+            const int first = package * 4;
+
+            write_file(directory / "topology" / "core_id", std::to_string(cpu % 2));
+            write_file(directory / "topology" / "physical_package_id", std::to_string(package));
+            std::filesystem::create_directories(directory / ("node" + std::to_string(package)));
+
+            write_file(directory / "cache" / "index0" / "level", "1");
+            write_file(directory / "cache" / "index0" / "coherency_line_size", "64");
+            write_file(directory / "cache" / "index0" / "shared_cpu_list", std::to_string(cpu) + "," + std::to_string(first + (cpu + 2) % 4));
+            write_file(directory / "cache" / "index3" / "level", "3");
+            write_file(directory / "cache" / "index3" / "shared_cpu_list", std::to_string(first) + "-" + std::to_string(first + 3));
+        }
+
+        return root;
+    }
+
+    bool test_parse_cpu_list() {
+        const auto cpus = parse_cpu_list("0-2,5,8-9\n");
+        const std::vector<int> expected{ 0, 1, 2, 5, 8, 9 };
+
+        if (cpus != expected || !parse_cpu_list("").empty()) {
+            std::clog << "parse_cpu_list does not parse the kernel format." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_discover_fake_sysfs() {
+        const auto root = make_fake_sysfs();
+        const auto topology = cpu_topology::discover(root);
+        std::filesystem::remove_all(root);
+
+        if (topology.cpus().size() != 8 || topology.cache_line_size() != 64) {
+            std::clog << "cpu_topology did not read every cpu." << std::endl;
+            return false;
+        }
+
+        const auto* cpu5 = topology.find(5);
+        if (cpu5 == nullptr || cpu5->core != 1 || cpu5->package != 1 || cpu5->node != 1 || cpu5->llc != 4) {
+            std::clog << "cpu_topology misread cpu 5." << std::endl;
+            return false;
+        }
+
+        if (!cpu_topology::smt_siblings(*topology.find(0), *topology.find(2)) || cpu_topology::smt_siblings(*topology.find(0), *topology.find(4))) {
+            std::clog << "cpu_topology does not detect siblings." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_producer_consumer_pair() {
+        const auto root = make_fake_sysfs();
+        const auto topology = cpu_topology::discover(root, {});
+        std::filesystem::remove_all(root);
+
+        const auto siblings = producer_consumer_pair(topology, pair_placement::smt_siblings);
+        const auto shared = producer_consumer_pair(topology, pair_placement::shared_cache);
+        const auto separate = producer_consumer_pair(topology, pair_placement::separate_cache);
+
+        if (!siblings || *siblings != std::make_pair(1, 3)) {
+            std::clog << "producer_consumer_pair picked wrong siblings." << std::endl;
+            return false;
+        }
+
+        if (!shared || *shared != std::make_pair(1, 2)) {
+            std::clog << "producer_consumer_pair picked a wrong shared cache pair." << std::endl;
+            return false;
+        }
+
+        if (!separate || *separate != std::make_pair(1, 4)) {
+            std::clog << "producer_consumer_pair picked a wrong separate cache pair." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_pin_thread() {
+        const auto allowed = cpu_topology::allowed_cpus();
+        if (allowed.empty()) {
+            return true;
+        }
+
+        bool pinned{ false };
+        std::thread worker{ [&] { pinned = pin_current_thread(allowed.back()); } };
+        worker.join();
+
+        if (!pinned || pin_current_thread(-1)) {
+            std::clog << "pin_current_thread does not work." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace topology {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_parse_cpu_list();
+        success = success & test_discover_fake_sysfs();
+        success = success & test_producer_consumer_pair();
+        success = success & test_pin_thread();
+
+        return success;
+    }
+
+} } }
@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_SYSTEM_TOPOLOGY_HPP_
+#define MRT_TESTS_SYSTEM_TOPOLOGY_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace topology {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
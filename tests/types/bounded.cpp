@@ -1,5 +1,9 @@
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <random>
 #include <stdexcept>
+#include <type_traits>
 #include "bounded.hpp"
 #include "../../types/bounded/bounded.hpp"
 
@@ -81,6 +85,181 @@ namespace {
         auto resultat = test % 4;
         return resultat.value() == 1;          
     }
+
+    bool test_operator_plus_overflow() {
+        constexpr int max = std::numeric_limits<int>::max();
+        bounded_range<int, 0, max> test(max - 1);
+
+        try {
+            auto resultat = test + 5;
+            std::clog << "test_operator_plus_overflow: failed: got " << resultat.value() << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        try {
+            ++test;
+            ++test;
+            std::clog << "test_operator_plus_overflow: failed: increment wrapped." << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        return test.value() == max;
+    }
+
+    bool test_operator_narrow_overflow() {
+        bounded_range<std::int8_t, -128, 127> test(std::int8_t{ 100 });
+
+        try {
+            auto resultat = test + 100;
+            std::clog << "test_operator_narrow_overflow: failed: got " << static_cast<int>(resultat.value()) << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        bounded_range<std::int8_t, -128, 127> lowest(std::int8_t{ -100 });
+        return (lowest - 28).value() == -128;
+    }
+
+    bool test_operator_divide_overflow() {
+        constexpr int min = std::numeric_limits<int>::min();
+        bounded_range<int, min, 0> test(int{ min });
+
+        try {
+            auto resultat = test / -1;
+            std::clog << "test_operator_divide_overflow: failed: got " << resultat.value() << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        // Narrow types divide in int: the quotient must not wrap back.
+        const bounded_range<std::int8_t, -128, 127> narrow(std::int8_t{ -128 });
+        const bounded_range<std::int16_t, -32768, 32767> short_narrow(std::int16_t{ -32768 });
+
+        try {
+            auto resultat = narrow / -1;
+            std::clog << "test_operator_divide_overflow: int8 failed: got " << int{ resultat.value() } << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        try {
+            auto resultat = short_narrow / -1;
+            (void)resultat;
+            std::clog << "test_operator_divide_overflow: int16 failed: did not throw" << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        if ((narrow / 2).value() != -64 || (narrow % -1).value() != 0) {
+            std::clog << "test_operator_divide_overflow: int8 division in range failed" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_operator_divide_floating() {
+        const bounded_range<double, 0.0, 10.0> distance(7.5);
+        bounded_range<double, 0.0, 10.0> mutable_distance(5.0);
+        mutable_distance / 4.0;
+
+        if ((distance / 2.0).value() != 3.75 || mutable_distance.value() != 1.25) {
+            std::clog << "test_operator_divide_floating: failed" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Differential check of the operators against 64-bit arithmetic for
+    // ranges that reach the limits of the value type.
+    bool test_operator_random_against_wide() {
+        constexpr std::int32_t min = std::numeric_limits<std::int32_t>::min();
+        constexpr std::int32_t max = std::numeric_limits<std::int32_t>::max();
+        using full_range = bounded_range<std::int32_t, min, max>;
+        using half_range = bounded_range<std::int32_t, min / 2, max / 2>;
+
+        std::mt19937 engine{ 2017 };
+        std::uniform_int_distribution<std::int32_t> distribution{ min, max };
+
+        auto expect = [](std::int64_t wide, std::int64_t lower, std::int64_t upper, auto&& operation) {
+            try {
+                auto resultat = operation();
+                return wide >= lower && wide <= upper && resultat.value() == wide;
+            }
+            catch (std::range_error&) {
+                return wide < lower || wide > upper;
+            }
+        };
+
+        for (int i = 0; i < 20000; ++i) {
+            const std::int32_t left = distribution(engine) / ((i % 3) + 1);
+            const std::int32_t right = distribution(engine) >> (i % 31);
+
+            full_range full(std::int32_t{ left });
+            bool success = expect(std::int64_t{ left } + right, min, max, [&] { return full + right; })
+                        && expect(std::int64_t{ left } - right, min, max, [&] { return full - right; })
+                        && expect(std::int64_t{ left } * right, min, max, [&] { return full * std::int32_t{ right }; });
+
+            if (left >= min / 2 && left <= max / 2) {
+                half_range half(std::int32_t{ left });
+                success = success
+                       && expect(std::int64_t{ left } + right, min / 2, max / 2, [&] { return half + right; })
+                       && expect(std::int64_t{ left } * right, min / 2, max / 2, [&] { return half * std::int32_t{ right }; });
+            }
+
+            if (!success) {
+                std::clog << "test_operator_random_against_wide: failed for " << left << " and " << right << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    using percent = bounded_range<int, 0, 100>;
+
+    constexpr auto squares = make_table<percent, 11>([](std::size_t i) { return static_cast<int>(i * i) % 101; });
+    static_assert(squares[10].value() == 100);
+    static_assert(squares.size() == 11);
+
+    constexpr percent half = bounded_constant<percent, 50>;
+    static_assert(half.value() == 50);
+    static_assert((percent(40) + 10).value() == 50);
+    static_assert((++percent(99)).value() == 100);
+
+    template<typename t_bounded_type, int value>
+    concept constant_compiles = requires { typename std::integral_constant<int, t_bounded_type(int{ value }).value()>; };
+
+    static_assert(constant_compiles<percent, 100>);
+    static_assert(!constant_compiles<percent, 101>);
+
+    using small = bounded_range<std::int8_t, 0, 100>;
+
+    template<int value>
+    concept table_compiles = requires { typename std::integral_constant<int, make_table<small, 1>([](std::size_t) { return value; })[0].value()>; };
+
+    static_assert(table_compiles<44>);
+    static_assert(!table_compiles<300>);
+
+    bool test_constexpr_table() {
+        for (std::size_t i = 0; i < squares.size(); ++i) {
+            if (squares[i].value() != static_cast<int>(i * i) % 101) {
+                std::clog << "test_constexpr_table: failed at " << i << std::endl;
+                return false;
+            }
+        }
+
+        return half.value() == 50;
+    }
 }
 
 namespace mrt { namespace tests { namespace bounded {
@@ -95,6 +274,12 @@ namespace mrt { namespace tests { namespace bounded {
         success = success & test_has_operator_divide();
         success = success & test_has_operator_multiply();
         success = success & test_has_operator_modulo();
+        success = success & test_operator_plus_overflow();
+        success = success & test_operator_narrow_overflow();
+        success = success & test_operator_divide_overflow();
+        success = success & test_operator_divide_floating();
+        success = success & test_operator_random_against_wide();
+        success = success & test_constexpr_table();
 
         return success;
     }
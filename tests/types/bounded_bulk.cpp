@@ -0,0 +1,127 @@
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "bounded_bulk.hpp"
+#include "../../types/bounded/bulk.hpp"
+
+using namespace mrt::types::bounded;
+
+namespace {
+    bool test_validate_all_valid() {
+        std::vector<int> values(1000);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] = static_cast<int>(i % 101);
+        }
+
+        auto index = validate<bounded_range<int, 0, 100>>(std::span<const int>(values));
+        if (index != values.size()) {
+            std::clog << "validate rejected a valid buffer at " << index << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_validate_first_violation() {
+        std::vector<int> values(1000, 50);
+        values[700] = 101;
+        values[900] = -1;
+
+        auto index = validate<bounded_range<int, 0, 100>>(std::span<const int>(values));
+        if (index != 700) {
+            std::clog << "validate did not return the first violation: " << index << std::endl;
+            return false;
+        }
+
+        values[3] = -1;
+        index = validate<bounded_range<int, 0, 100>>(std::span<const int>(values));
+        if (index != 3) {
+            std::clog << "validate did not return the first violation: " << index << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_validate_tail() {
+        std::vector<int> values(70, 1);
+        values[69] = 0;
+
+        auto index = validate<bounded_range<int, 1, 10>>(std::span<const int>(values));
+        if (index != 69) {
+            std::clog << "validate missed a violation in the trailing partial block." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_validate_nan() {
+        std::vector<double> values(128, 0.5);
+        values[100] = std::numeric_limits<double>::quiet_NaN();
+
+        auto index = validate<bounded_range<double, 0.0, 1.0>>(std::span<const double>(values));
+        if (index != 100) {
+            std::clog << "validate accepted NaN." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_from_span() {
+        std::vector<int> values{ 1, 2, 3, 4, 200, 6 };
+        std::vector<bounded_range<int, 0, 100>> out(values.size());
+
+        auto converted = from_span(std::span<const int>(values), std::span(out));
+        if (converted != 4) {
+            std::clog << "from_span did not stop at the violation." << std::endl;
+            return false;
+        }
+
+        for (std::size_t i = 0; i < converted; ++i) {
+            if (out[i].value() != values[i]) {
+                std::clog << "from_span did not copy converted values." << std::endl;
+                return false;
+            }
+        }
+
+        values[4] = 5;
+        converted = from_span(std::span<const int>(values), std::span(out));
+        if (converted != values.size() || out[5].value() != 6) {
+            std::clog << "from_span did not convert the whole buffer." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_from_span_short_output() {
+        std::vector<int> values(100, 7);
+        std::vector<bounded_range<int, 0, 100>> out(10);
+
+        const auto converted = from_span(std::span<const int>(values), std::span(out));
+        if (converted != out.size() || out[9].value() != 7) {
+            std::clog << "from_span did not stop at the end of out." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace bounded_bulk {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_validate_all_valid();
+        success = success & test_validate_first_violation();
+        success = success & test_validate_tail();
+        success = success & test_validate_nan();
+        success = success & test_from_span();
+        success = success & test_from_span_short_output();
+
+        return success;
+    }
+
+} } }
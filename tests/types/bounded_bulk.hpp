@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_TYPES_BOUNDED_BULK_HPP_
+#define MRT_TESTS_TYPES_BOUNDED_BULK_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace bounded_bulk {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
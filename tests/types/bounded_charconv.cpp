@@ -0,0 +1,169 @@
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+#include "bounded_charconv.hpp"
+#include "../../types/bounded/charconv.hpp"
+
+using namespace mrt::types::bounded;
+
+namespace {
+    bool test_parse_bounded() {
+        const char text[] = "42";
+        bounded_range<int, 0, 100> value(1);
+
+        auto result = parse_bounded(text, text + 2, value);
+        if (result.ec != std::errc{} || result.ptr != text + 2 || value.value() != 42) {
+            std::clog << "parse_bounded failed to parse a valid value." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_parse_bounded_out_of_range() {
+        const char text[] = "101";
+        bounded_range<int, 0, 100> value(7);
+
+        auto result = parse_bounded(text, text + 3, value);
+        if (result.ec != std::errc::result_out_of_range || value.value() != 7) {
+            std::clog << "parse_bounded accepted an out of range value." << std::endl;
+            return false;
+        }
+
+        const char garbage[] = "abc";
+        result = parse_bounded(garbage, garbage + 3, value);
+        if (result.ec != std::errc::invalid_argument || value.value() != 7) {
+            std::clog << "parse_bounded accepted garbage." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_format_to() {
+        char buffer[16];
+        bounded_range<int, -100, 100> value(-57);
+
+        auto result = format_to(buffer, buffer + sizeof(buffer), value);
+        if (result.ec != std::errc{} || std::string_view(buffer, result.ptr - buffer) != "-57") {
+            std::clog << "format_to did not format the value." << std::endl;
+            return false;
+        }
+
+        result = format_to(buffer, buffer + 2, value);
+        if (result.ec != std::errc::value_too_large) {
+            std::clog << "format_to did not report a short buffer." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_parse_delimited() {
+        const char text[] = "1, 2,3 ,\t4,5";
+        bounded_range<int, 0, 10> values[8];
+
+        auto result = parse_delimited(text, text + std::strlen(text), ',', std::span(values));
+        if (result.ec != std::errc{} || result.count != 5 || result.ptr != text + std::strlen(text)) {
+            std::clog << "parse_delimited did not decode every field." << std::endl;
+            return false;
+        }
+
+        for (int i = 0; i < 5; ++i) {
+            if (values[i].value() != i + 1) {
+                std::clog << "parse_delimited decoded a wrong value." << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool test_parse_delimited_resume() {
+        const char text[] = "1;2;3;4;5";
+        const char* last = text + std::strlen(text);
+        bounded_range<int, 0, 10> values[2];
+
+        auto result = parse_delimited(text, last, ';', std::span(values));
+        if (result.count != 2 || result.ptr != text + 4) {
+            std::clog << "parse_delimited did not stop when the output was full." << std::endl;
+            return false;
+        }
+
+        result = parse_delimited(result.ptr, last, ';', std::span(values));
+        if (result.count != 2 || values[0].value() != 3 || values[1].value() != 4) {
+            std::clog << "parse_delimited did not resume from ptr." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_parse_delimited_chunks() {
+        const char chunk[] = "12,34,5";
+        const char* last = chunk + std::strlen(chunk);
+        bounded_range<int, 0, 1000> values[4];
+
+        auto result = parse_delimited(chunk, last, ',', std::span(values), false);
+        if (result.ec != std::errc{} || result.count != 2 || result.ptr != chunk + 6) {
+            std::clog << "parse_delimited decoded a field cut at the end of a chunk." << std::endl;
+            return false;
+        }
+
+        // The caller carries the cut field over to the next chunk.
+        const char next[] = "567,8";
+        result = parse_delimited(next, next + std::strlen(next), ',', std::span(values), true);
+        if (result.ec != std::errc{} || result.count != 2 || values[0].value() != 567 || values[1].value() != 8) {
+            std::clog << "parse_delimited did not decode the final chunk." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_parse_delimited_errors() {
+        const char text[] = "1,20,3";
+        bounded_range<int, 0, 10> values[4];
+
+        auto result = parse_delimited(text, text + std::strlen(text), ',', std::span(values));
+        if (result.ec != std::errc::result_out_of_range || result.count != 1 || result.ptr != text + 2) {
+            std::clog << "parse_delimited did not report the out of range field." << std::endl;
+            return false;
+        }
+
+        const char missing[] = "1 2";
+        result = parse_delimited(missing, missing + std::strlen(missing), ',', std::span(values));
+        if (result.ec != std::errc::invalid_argument || result.count != 0 || result.ptr != missing) {
+            std::clog << "parse_delimited accepted a missing delimiter." << std::endl;
+            return false;
+        }
+
+        const char garbage[] = "7,5abc,3";
+        values[1] = 0;
+        result = parse_delimited(garbage, garbage + std::strlen(garbage), ',', std::span(values));
+        if (result.ec != std::errc::invalid_argument || result.count != 1 || result.ptr != garbage + 2 || values[1].value() != 0) {
+            std::clog << "parse_delimited counted a field with trailing characters." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace bounded_charconv {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_parse_bounded();
+        success = success & test_parse_bounded_out_of_range();
+        success = success & test_format_to();
+        success = success & test_parse_delimited();
+        success = success & test_parse_delimited_resume();
+        success = success & test_parse_delimited_chunks();
+        success = success & test_parse_delimited_errors();
+
+        return success;
+    }
+
+} } }
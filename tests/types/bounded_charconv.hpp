@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_TYPES_BOUNDED_CHARCONV_HPP_
+#define MRT_TESTS_TYPES_BOUNDED_CHARCONV_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace bounded_charconv {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
@@ -0,0 +1,123 @@
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "bounded_fixed.hpp"
+#include "../../types/bounded/bounded_fixed.hpp"
+
+using namespace mrt::types::bounded;
+
+namespace {
+    using gain = bounded_fixed<0.0, 1.0, 15>;
+    using offset = bounded_fixed<-4.0, 4.0, 12>;
+
+    static_assert(std::is_same_v<gain::storage_type, std::uint16_t>);
+    static_assert(std::is_same_v<offset::storage_type, std::int16_t>);
+    static_assert(std::is_same_v<bounded_fixed<0.0, 100.0, 24>::storage_type, std::uint32_t>);
+    static_assert(sizeof(gain) == 2);
+
+    bool test_fixed_conversion() {
+        gain half(0.5);
+        if (half.raw() != 16384 || half.value() != 0.5) {
+            std::clog << "bounded_fixed does not convert 0.5." << std::endl;
+            return false;
+        }
+
+        if (gain(1.0).raw() != 32768 || offset(-1.5).value() != -1.5) {
+            std::clog << "bounded_fixed does not convert its bounds." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_fixed_range() {
+        try {
+            gain(1.01);
+            std::clog << "bounded_fixed accepted a value above the range." << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        try {
+            offset(-4.5);
+            std::clog << "bounded_fixed accepted a value below the range." << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        try {
+            auto sum = gain(0.75) + gain(0.5);
+            std::clog << "bounded_fixed addition left the range: " << sum.value() << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        return true;
+    }
+
+    bool test_fixed_arithmetic() {
+        if ((gain(0.5) * gain(0.5)).value() != 0.25 || (gain(0.75) - gain(0.25)).value() != 0.5) {
+            std::clog << "bounded_fixed gain arithmetic is incorrect." << std::endl;
+            return false;
+        }
+
+        if ((offset(-1.5) * offset(2.0)).value() != -3.0 || (offset(3.0) / offset(-2.0)).value() != -1.5) {
+            std::clog << "bounded_fixed signed arithmetic is incorrect." << std::endl;
+            return false;
+        }
+
+        if (!(gain(0.25) < gain(0.5)) || gain(0.5) != gain(0.5)) {
+            std::clog << "bounded_fixed comparisons are incorrect." << std::endl;
+            return false;
+        }
+
+        try {
+            offset(3.0) * offset(2.0);
+            std::clog << "bounded_fixed multiplication left the range." << std::endl;
+            return false;
+        }
+        catch (std::range_error&) {
+        }
+
+        return true;
+    }
+
+    bool test_fixed_batch() {
+        std::vector<offset> left{ offset(1.0), offset(3.5), offset(-3.0), offset(0.5) };
+        std::vector<offset> right{ offset(2.0), offset(1.0), offset(-2.0), offset(-0.25) };
+        std::vector<offset> out(4);
+
+        offset::add_saturated(left, right, out);
+        if (out[0].value() != 3.0 || out[1].value() != 4.0 || out[2].value() != -4.0 || out[3].value() != 0.25) {
+            std::clog << "bounded_fixed add_saturated is incorrect." << std::endl;
+            return false;
+        }
+
+        offset::multiply_saturated(left, right, out);
+        if (out[0].value() != 2.0 || out[1].value() != 3.5 || out[2].value() != 4.0 || out[3].value() != -0.125) {
+            std::clog << "bounded_fixed multiply_saturated is incorrect." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace bounded_fixed {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_fixed_conversion();
+        success = success & test_fixed_range();
+        success = success & test_fixed_arithmetic();
+        success = success & test_fixed_batch();
+
+        return success;
+    }
+
+} } }
@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_TYPES_BOUNDED_FIXED_HPP_
+#define MRT_TESTS_TYPES_BOUNDED_FIXED_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace bounded_fixed {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
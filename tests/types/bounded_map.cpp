@@ -0,0 +1,167 @@
+#include <iostream>
+#include <string>
+#include "bounded_map.hpp"
+#include "../../types/bounded/bounded_map.hpp"
+
+using namespace mrt::types::bounded;
+
+namespace {
+    using status_code = bounded_range<int, 100, 599>;
+
+    bool test_set_insert_erase() {
+        bounded_set<status_code> set;
+
+        if (!set.insert(status_code(200)) || set.insert(status_code(200))) {
+            std::clog << "bounded_set insert does not report duplicates." << std::endl;
+            return false;
+        }
+
+        set.insert(status_code(100));
+        set.insert(status_code(599));
+
+        if (set.size() != 3 || !set.contains(status_code(599)) || set.contains(status_code(404))) {
+            std::clog << "bounded_set does not track its keys." << std::endl;
+            return false;
+        }
+
+        if (!set.erase(status_code(200)) || set.erase(status_code(200)) || set.size() != 2) {
+            std::clog << "bounded_set erase does not work." << std::endl;
+            return false;
+        }
+
+        set.clear();
+        if (!set.empty() || set.begin() != set.end()) {
+            std::clog << "bounded_set is not empty after clear." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_set_iteration_order() {
+        bounded_set<bounded_range<int, -70, 70>> set;
+        const int keys[] = { 70, -70, 0, 63, -7, 64 };
+
+        for (int key : keys) {
+            set.insert(bounded_range<int, -70, 70>(int{ key }));
+        }
+
+        const int expected[] = { -70, -7, 0, 63, 64, 70 };
+        int position = 0;
+
+        for (auto key : set) {
+            if (position >= 6 || key.value() != expected[position]) {
+                std::clog << "bounded_set does not iterate in key order." << std::endl;
+                return false;
+            }
+
+            ++position;
+        }
+
+        return position == 6;
+    }
+
+    bool test_map_lookup() {
+        bounded_map<status_code, std::string> map;
+        map.insert(status_code(404), "Not Found");
+        map[status_code(200)] = "OK";
+
+        if (map.size() != 2 || map.at(status_code(404)) != "Not Found" || map[status_code(200)] != "OK") {
+            std::clog << "bounded_map lookup does not work." << std::endl;
+            return false;
+        }
+
+        if (map.find(status_code(500)) != nullptr || map.contains(status_code(500))) {
+            std::clog << "bounded_map finds a missing key." << std::endl;
+            return false;
+        }
+
+        try {
+            map.at(status_code(500));
+            std::clog << "bounded_map at does not throw for a missing key." << std::endl;
+            return false;
+        }
+        catch (std::out_of_range&) {
+        }
+
+        if (map.insert(status_code(404), "Other") || map.at(status_code(404)) != "Not Found") {
+            std::clog << "bounded_map insert overwrote an existing value." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_map_erase_and_iterate() {
+        bounded_map<status_code, int> counters;
+
+        for (int code : { 503, 200, 200, 301, 200, 503 }) {
+            ++counters[status_code(int{ code })];
+        }
+
+        counters.erase(status_code(301));
+
+        const int expected_keys[] = { 200, 503 };
+        const int expected_counts[] = { 3, 2 };
+        int position = 0;
+
+        for (auto it = counters.begin(); it != counters.end(); ++it) {
+            if (position >= 2 || it.key().value() != expected_keys[position] || *it != expected_counts[position]) {
+                std::clog << "bounded_map iteration does not visit occupied slots in order." << std::endl;
+                return false;
+            }
+
+            ++position;
+        }
+
+        bounded_map<status_code, int> copy{ counters };
+        if (position != 2 || copy.size() != 2 || copy.at(status_code(503)) != 2) {
+            std::clog << "bounded_map copy does not work." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_map_wide_range() {
+        using wide_key = bounded_range<int, 0, (1 << 20) - 1>;
+
+        bounded_map<wide_key, std::string> map;
+        if (sizeof(map) > sizeof(bounded_set<wide_key>) + sizeof(void*)) {
+            std::clog << "bounded_map stores its slots inline." << std::endl;
+            return false;
+        }
+
+        map[wide_key((1 << 20) - 1)] = "last";
+
+        bounded_map<wide_key, std::string> moved{ std::move(map) };
+        if (moved.size() != 1 || moved.at(wide_key((1 << 20) - 1)) != "last" || !map.empty()) {
+            std::clog << "bounded_map move does not transfer the slots." << std::endl;
+            return false;
+        }
+
+        map[wide_key(0)] = "first";
+        map = std::move(moved);
+        if (map.size() != 1 || map.contains(wide_key(0)) || !moved.empty()) {
+            std::clog << "bounded_map move assignment does not replace the slots." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace bounded_map {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_set_insert_erase();
+        success = success & test_set_iteration_order();
+        success = success & test_map_lookup();
+        success = success & test_map_erase_and_iterate();
+        success = success & test_map_wide_range();
+
+        return success;
+    }
+
+} } }
@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_TYPES_BOUNDED_MAP_HPP_
+#define MRT_TESTS_TYPES_BOUNDED_MAP_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace bounded_map {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
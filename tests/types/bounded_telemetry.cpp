@@ -0,0 +1,86 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "bounded_telemetry.hpp"
+#include "../../types/bounded/bounded.hpp"
+#include "../../types/bounded/telemetry.hpp"
+
+using namespace mrt::types::bounded;
+
+namespace {
+    using gain_constraint = range_constraint<int, 0, 160>;
+
+    struct even_constraint {
+        bool operator()(const int& value) const noexcept {
+            return value % 2 == 0;
+        }
+    };
+
+    bool test_counters() {
+        const gain_constraint constraint;
+        for (int value : { 80, 5, 155, 161, -3, 100 }) {
+            telemetry::record<int, gain_constraint>(value, constraint(value));
+        }
+
+        const auto& entry = telemetry::counters_for<int, gain_constraint>();
+        if (entry.checks.load() != 6 || entry.violations.load() != 2 || entry.near_boundary.load() != 2) {
+            std::clog << "telemetry counters are incorrect: " << entry.checks.load() << ", "
+                      << entry.violations.load() << ", " << entry.near_boundary.load() << std::endl;
+            return false;
+        }
+
+        if (entry.samples_taken.load() != 1 || entry.samples[0].load() != 161.0) {
+            std::clog << "telemetry did not sample the first violation." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_custom_constraint() {
+        const even_constraint constraint;
+        for (int value : { 2, 3, 4 }) {
+            telemetry::record<int, even_constraint>(value, constraint(value));
+        }
+
+        const auto& entry = telemetry::counters_for<int, even_constraint>();
+        if (entry.has_range || entry.checks.load() != 3 || entry.violations.load() != 1 || entry.near_boundary.load() != 0) {
+            std::clog << "telemetry counters for a custom constraint are incorrect." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_dump_and_reset() {
+        std::ostringstream out;
+        telemetry::registry::dump(out);
+
+        const auto report = out.str();
+        if (report.find("range_constraint<int, 0, 160>") == std::string::npos || report.find("violations=2") == std::string::npos) {
+            std::clog << "telemetry dump is missing an entry: " << report << std::endl;
+            return false;
+        }
+
+        telemetry::registry::reset();
+        if (telemetry::counters_for<int, gain_constraint>().checks.load() != 0) {
+            std::clog << "telemetry reset did not clear the counters." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace bounded_telemetry {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_counters();
+        success = success & test_custom_constraint();
+        success = success & test_dump_and_reset();
+
+        return success;
+    }
+
+} } }
@@ -0,0 +1,100 @@
+// Builds bounded.hpp with the telemetry hook while the other test sources
+// include it without the macro. As telemetry.hpp requires, no bounded
+// specialization is shared between the two settings: this file only
+// instantiates constraints of its own anonymous namespace.
+#define MRT_BOUNDED_TELEMETRY
+
+#include <cstring>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "bounded_telemetry_hook.hpp"
+#include "../../types/bounded/bounded.hpp"
+#include "../../types/bounded/bulk.hpp"
+#include "../../types/bounded/charconv.hpp"
+
+using namespace mrt::types::bounded;
+
+namespace {
+    // One counters entry per test.
+    template<int t_tag>
+    struct gain_constraint {
+        static constexpr int lower = 0;
+        static constexpr int upper = 160;
+
+        bool operator()(const int& value) const noexcept {
+            return value >= lower && value <= upper;
+        }
+    };
+
+    using hook_constraint = gain_constraint<0>;
+    using bulk_constraint = gain_constraint<1>;
+    using parse_constraint = gain_constraint<2>;
+
+    using hook_value = bounded<int, hook_constraint>;
+
+    bool test_assign_is_counted() {
+        hook_value gain(80);
+        gain = 155;
+
+        try {
+            gain = 161;
+        } catch (const std::range_error&) {
+        }
+
+        const auto& entry = telemetry::counters_for<int, hook_constraint>();
+        if (entry.checks.load() != 3 || entry.violations.load() != 1 || entry.near_boundary.load() != 1) {
+            std::clog << "telemetry did not count construction and assignment: " << entry.checks.load() << ", "
+                      << entry.violations.load() << ", " << entry.near_boundary.load() << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_from_span_is_counted() {
+        std::vector<int> values(100, 80);
+        values[70] = 200;
+        std::vector<bounded<int, bulk_constraint>> out(values.size());
+
+        from_span(std::span<const int>(values), std::span(out));
+
+        const auto& entry = telemetry::counters_for<int, bulk_constraint>();
+        if (entry.checks.load() != 71 || entry.violations.load() != 1) {
+            std::clog << "telemetry did not count from_span checks." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool test_parse_is_counted() {
+        const char text[] = "10,500";
+        bounded<int, parse_constraint> values[2]{ bounded<int, parse_constraint>(0), bounded<int, parse_constraint>(0) };
+
+        parse_delimited(text, text + std::strlen(text), ',', std::span(values));
+
+        // Two constructions, then two parsed fields.
+        const auto& entry = telemetry::counters_for<int, parse_constraint>();
+        if (entry.checks.load() != 4 || entry.violations.load() != 1) {
+            std::clog << "telemetry did not count parse_bounded checks." << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+namespace mrt { namespace tests { namespace bounded_telemetry_hook {
+
+    bool execute() noexcept {
+        bool success{ true };
+        success = success & test_assign_is_counted();
+        success = success & test_from_span_is_counted();
+        success = success & test_parse_is_counted();
+
+        return success;
+    }
+
+} } }
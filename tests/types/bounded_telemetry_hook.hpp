@@ -0,0 +1,12 @@
+#ifndef MRT_TESTS_TYPES_BOUNDED_TELEMETRY_HOOK_HPP_
+#define MRT_TESTS_TYPES_BOUNDED_TELEMETRY_HOOK_HPP_
+
+#include <iostream>
+
+namespace mrt { namespace tests { namespace bounded_telemetry_hook {
+
+bool execute() noexcept;
+
+} } }
+
+#endif
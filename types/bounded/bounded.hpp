@@ -1,20 +1,36 @@
 #ifndef MRT_TYPES_BOUNDED_BOUNDED_HPP_
 #define MRT_TYPES_BOUNDED_BOUNDED_HPP_
 
+#include <array>
+#include <cstddef>
 #include <istream>
+#include <limits>
 #include <ostream>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifdef MRT_BOUNDED_TELEMETRY
+#include "telemetry.hpp"
+#endif
 
 namespace mrt { namespace types { namespace bounded {
     template <typename t_bounded, typename t_constraint> class bounded;
     template <typename t_bounded, typename t_constraint> std::ostream& operator<<(std::ostream&, const bounded<t_bounded, t_constraint>&);
     template <typename t_bounded, typename t_constraint> std::istream& operator>>(std::istream&, bounded<t_bounded, t_constraint>&);
+
+    namespace detail {
+        struct bounded_access;
+    }
     
     template<typename t_bounded, t_bounded lower_bound, t_bounded upper_bound>
     class range_constraint final {
         static_assert(lower_bound <= upper_bound, "Lower bound must be lower or equal to upper bound");
     
     public:
+        static constexpr t_bounded lower = lower_bound;
+        static constexpr t_bounded upper = upper_bound;
+
         constexpr bool operator()(const t_bounded& value) const noexcept {
             return value >= lower_bound && value <= upper_bound;
         }
@@ -24,96 +40,282 @@ namespace mrt { namespace types { namespace bounded {
         }
     };
 
+    namespace detail {
+        template<typename t_constraint>
+        struct is_range_constraint : std::false_type {};
+
+        template<typename t_bounded, t_bounded lower_bound, t_bounded upper_bound>
+        struct is_range_constraint<range_constraint<t_bounded, lower_bound, upper_bound>> : std::true_type {};
+
+        template<typename t_value>
+        constexpr bool is_checked_integral_v = std::is_integral_v<t_value> && !std::is_same_v<t_value, bool>;
+
+        enum class arithmetic { add, subtract, multiply };
+
+        [[noreturn]] inline void throw_out_of_range() {
+            throw std::range_error("Value is out of constraint range.");
+        }
+
+        template<arithmetic t_operation, typename t_left, typename t_right>
+        constexpr auto apply(const t_left& left, const t_right& right) {
+            if constexpr (t_operation == arithmetic::add) {
+                return left + right;
+            } else if constexpr (t_operation == arithmetic::subtract) {
+                return left - right;
+            } else {
+                return left * right;
+            }
+        }
+
+        // True when the exact result of left <op> right does not fit in
+        // t_result; otherwise stores it in result.
+        template<arithmetic t_operation, typename t_result, typename t_left, typename t_right>
+        constexpr bool overflows(t_left left, t_right right, t_result& result) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            if constexpr (t_operation == arithmetic::add) {
+                return __builtin_add_overflow(left, right, &result);
+            } else if constexpr (t_operation == arithmetic::subtract) {
+                return __builtin_sub_overflow(left, right, &result);
+            } else {
+                return __builtin_mul_overflow(left, right, &result);
+            }
+#else
+            // Portable path: operands that do not fit t_result are treated
+            // as overflowing, even if the exact result would have fit.
+            if (false == std::in_range<t_result>(left) || false == std::in_range<t_result>(right)) {
+                return true;
+            }
+
+            using limits = std::numeric_limits<t_result>;
+            const auto a = static_cast<t_result>(left);
+            const auto b = static_cast<t_result>(right);
+
+            if constexpr (t_operation == arithmetic::add) {
+                if (b > 0 ? a > limits::max() - b : a < limits::min() - b) return true;
+            } else if constexpr (t_operation == arithmetic::subtract) {
+                if (b > 0 ? a < limits::min() + b : a > limits::max() + b) return true;
+            } else if constexpr (std::is_unsigned_v<t_result>) {
+                if (b != 0 && a > limits::max() / b) return true;
+            } else {
+                if (a > 0 ? (b > 0 ? a > limits::max() / b : b < limits::min() / a)
+                          : (b > 0 ? a < limits::min() / b : a != 0 && b < limits::max() / a)) return true;
+            }
+
+            result = static_cast<t_result>(apply<t_operation>(a, b));
+            return false;
+#endif
+        }
+
+        // The result of an operation over a static range is monotonic in
+        // each operand, so checking the corners of [lower, upper] x operand
+        // limits proves whether any value can overflow.
+        template<arithmetic t_operation, typename t_bounded, typename t_constraint, typename t_operand>
+        constexpr bool may_overflow() noexcept {
+            if constexpr (is_range_constraint<t_constraint>::value) {
+                const t_bounded bounds[] = { t_constraint::lower, t_constraint::upper };
+                const t_operand operands[] = { std::numeric_limits<t_operand>::min(), std::numeric_limits<t_operand>::max() };
+                t_bounded result{};
+
+                for (const auto bound : bounds) {
+                    for (const auto operand : operands) {
+                        if (overflows<t_operation>(bound, operand, result)) {
+                            return true;
+                        }
+                    }
+                }
+
+                return false;
+            } else {
+                return true;
+            }
+        }
+
+        // Computes value <op> operand, throwing std::range_error instead of
+        // overflowing the value type. Non integral operations are left as is.
+        template<arithmetic t_operation, typename t_constraint, typename t_bounded, typename t_operand>
+        constexpr auto checked(const t_bounded& value, const t_operand& operand) {
+            if constexpr (is_checked_integral_v<t_bounded> && is_checked_integral_v<t_operand>) {
+                if constexpr (may_overflow<t_operation, t_bounded, t_constraint, t_operand>()) {
+                    t_bounded result{};
+                    if (overflows<t_operation>(value, operand, result)) {
+                        throw_out_of_range();
+                    }
+
+                    return result;
+                } else {
+                    return static_cast<t_bounded>(apply<t_operation>(value, operand));
+                }
+            } else {
+                return apply<t_operation>(value, operand);
+            }
+        }
+
+        // ++ and -- only overflow when the range touches the type limits.
+        template<arithmetic t_operation, typename t_constraint, typename t_bounded>
+        constexpr auto checked_step(const t_bounded& value) {
+            if constexpr (is_checked_integral_v<t_bounded> && is_range_constraint<t_constraint>::value) {
+                constexpr bool at_limit = t_operation == arithmetic::add
+                    ? t_constraint::upper == std::numeric_limits<t_bounded>::max()
+                    : t_constraint::lower == std::numeric_limits<t_bounded>::min();
+
+                if constexpr (at_limit) {
+                    t_bounded result{};
+                    if (overflows<t_operation>(value, 1, result)) {
+                        throw_out_of_range();
+                    }
+
+                    return result;
+                } else {
+                    return static_cast<t_bounded>(apply<t_operation>(value, 1));
+                }
+            } else {
+                return checked<t_operation, t_constraint>(value, t_bounded{ 1 });
+            }
+        }
+
+        // Division and modulo only overflow for min / -1 in a signed type.
+        template<typename t_constraint, typename t_bounded, typename t_operand>
+        constexpr void check_division(const t_bounded& value, const t_operand& operand) {
+            if constexpr (is_checked_integral_v<t_bounded> && is_checked_integral_v<t_operand> && std::is_signed_v<t_operand>) {
+                using t_common = decltype(value / operand);
+                constexpr auto minimum = std::numeric_limits<t_common>::min();
+
+                if constexpr (std::is_signed_v<t_common>) {
+                    constexpr bool reachable = is_range_constraint<t_constraint>::value
+                        ? t_constraint::lower <= minimum
+                        : true;
+
+                    if constexpr (reachable) {
+                        if (operand == -1 && value == minimum) {
+                            throw_out_of_range();
+                        }
+                    }
+                }
+            }
+        }
+
+        // Integral value converted to t_bounded, throwing when it does not
+        // fit instead of wrapping. Non integral values are returned as is.
+        template<typename t_bounded, typename t_value>
+        constexpr auto checked_narrow(const t_value& value) {
+            if constexpr (is_checked_integral_v<t_bounded> && is_checked_integral_v<t_value>) {
+                const auto narrowed = static_cast<t_bounded>(value);
+                if (static_cast<t_value>(narrowed) != value || (narrowed < 0) != (value < 0)) {
+                    throw_out_of_range();
+                }
+
+                return narrowed;
+            } else {
+                return value;
+            }
+        }
+
+        // Quotient or remainder converted back to the value type. Narrow
+        // types are promoted, so int8 -128 / -1 yields an int 128 that must
+        // not wrap back to -128 on the way into the bounded.
+        template<typename t_constraint, bool remainder, typename t_bounded, typename t_operand>
+        constexpr auto checked_division(const t_bounded& value, const t_operand& operand) {
+            check_division<t_constraint>(value, operand);
+
+            if constexpr (remainder) {
+                return checked_narrow<t_bounded>(value % operand);
+            } else {
+                return checked_narrow<t_bounded>(value / operand);
+            }
+        }
+    }
+
     template<typename t_bounded, typename t_constraint>
     class bounded {
     public:
         using value_type = t_bounded;
+        using constraint_type = t_constraint;
     
         bounded() = default;
     
-        explicit bounded(t_bounded&& value) {
+        constexpr explicit bounded(t_bounded&& value) {
             assign(std::move(value));
         }
     
-        auto operator=(const t_bounded& value) {
+        constexpr auto operator=(const t_bounded& value) {
             assign(value);
         }
     
-        auto operator=(t_bounded&& value) {
+        constexpr auto operator=(t_bounded&& value) {
             assign(std::move(value));
         }
     
-        auto operator->() noexcept {
+        constexpr auto operator->() noexcept {
             return &m_value;
         }
     
-        auto operator->() const noexcept {
+        constexpr auto operator->() const noexcept {
             return &m_value;
         }
     
-        explicit operator t_bounded() const {
+        constexpr explicit operator t_bounded() const {
             return m_value;
         }
     
-        t_bounded value() const {
+        constexpr t_bounded value() const {
             return m_value;
         }
 
     public:
         template<typename t_operand>
-        auto operator+(t_operand&& op) {
-            return bounded<t_bounded, t_constraint>(m_value + op);
+        constexpr auto operator+(t_operand&& op) {
+            return bounded<t_bounded, t_constraint>(detail::checked<detail::arithmetic::add, t_constraint>(m_value, op));
         }
         
-        auto& operator++() {
-            return assign(m_value + 1);
+        constexpr auto& operator++() {
+            return assign(detail::checked_step<detail::arithmetic::add, t_constraint>(m_value));
         }
 
-        auto operator++(int) {
-            return bounded<t_bounded, t_constraint>(m_value + 1);
+        constexpr auto operator++(int) {
+            return bounded<t_bounded, t_constraint>(detail::checked_step<detail::arithmetic::add, t_constraint>(m_value));
         }
 
         template<typename t_operand>
-        auto operator-(t_operand&& op) {
-            return bounded<t_bounded, t_constraint>(m_value - op);
+        constexpr auto operator-(t_operand&& op) {
+            return bounded<t_bounded, t_constraint>(detail::checked<detail::arithmetic::subtract, t_constraint>(m_value, op));
         }
 
-        auto& operator--() {
-            return assign(m_value - 1);
+        constexpr auto& operator--() {
+            return assign(detail::checked_step<detail::arithmetic::subtract, t_constraint>(m_value));
         }
 
-        auto operator--(int) {
-            return bounded<t_bounded, t_constraint>(m_value - 1);
+        constexpr auto operator--(int) {
+            return bounded<t_bounded, t_constraint>(detail::checked_step<detail::arithmetic::subtract, t_constraint>(m_value));
         }
 
         template<typename t_operand>
-        auto operator*(const t_operand&& operand) const {
-            return bounded<t_bounded, t_constraint>(m_value * operand);
+        constexpr auto operator*(const t_operand&& operand) const {
+            return bounded<t_bounded, t_constraint>(detail::checked<detail::arithmetic::multiply, t_constraint>(m_value, operand));
         }
 
         template<typename t_operand>
-        auto& operator*(const t_operand&& operand) {
-            return assign(m_value * operand);
+        constexpr auto& operator*(const t_operand&& operand) {
+            return assign(detail::checked<detail::arithmetic::multiply, t_constraint>(m_value, operand));
         }
 
         template<typename t_operand>
-        auto operator/(const t_operand&& operand) const {
-            return bounded<t_bounded, t_constraint>(m_value / operand);
+        constexpr auto operator/(const t_operand&& operand) const {
+            return bounded<t_bounded, t_constraint>(detail::checked_division<t_constraint, false>(m_value, operand));
         }
 
         template<typename t_operand>
-        auto& operator/(const t_operand&& operand) {
-            return assign(m_value / operand);
+        constexpr auto& operator/(const t_operand&& operand) {
+            return assign(detail::checked_division<t_constraint, false>(m_value, operand));
         }
 
         template<typename t_operand>
-        auto operator%(const t_operand&& operand) const {
-            return bounded<t_bounded, t_constraint>(m_value % operand);
+        constexpr auto operator%(const t_operand&& operand) const {
+            return bounded<t_bounded, t_constraint>(detail::checked_division<t_constraint, true>(m_value, operand));
         }
 
         template<typename t_operand>
-        auto& operator%(const t_operand&& operand) {
-            return assign(m_value % operand);
+        constexpr auto& operator%(const t_operand&& operand) {
+            return assign(detail::checked_division<t_constraint, true>(m_value, operand));
         }
 
     public:
@@ -121,11 +323,21 @@ namespace mrt { namespace types { namespace bounded {
     
         friend std::ostream& operator<< <t_bounded, t_constraint> (std::ostream&, const bounded<t_bounded, t_constraint>&);
         friend std::istream& operator>> <t_bounded, t_constraint> (std::istream&, bounded<t_bounded, t_constraint>&);
+
+        friend struct detail::bounded_access;
     
     private:
         template<typename t_assign_value>
-        auto& assign(t_assign_value&& value) {
+        constexpr auto& assign(t_assign_value&& value) {
+#ifdef MRT_BOUNDED_TELEMETRY
+            const bool accepted = std::is_constant_evaluated()
+                ? m_constraint(value)
+                : telemetry::record<t_bounded, t_constraint>(value, m_constraint(value));
+
+            if (false == accepted) {
+#else
             if (false == m_constraint(value)) {
+#endif
                 throw std::range_error("Value is out of constraint range.");
             }
     
@@ -138,6 +350,29 @@ namespace mrt { namespace types { namespace bounded {
         t_bounded m_value;
     };
     
+    namespace detail {
+        // Lets batch routines store values they have already validated
+        // without going through assign() a second time.
+        struct bounded_access {
+            template<typename t_bounded, typename t_constraint>
+            static constexpr void store_unchecked(bounded<t_bounded, t_constraint>& target, const t_bounded& value) noexcept {
+                target.m_value = value;
+            }
+        };
+
+        // The constraint check of the paths that bypass assign() and then
+        // call store_unchecked, so telemetry counts them as well.
+        template<typename t_bounded, typename t_constraint, typename t_value>
+        constexpr bool check_constraint(const t_value& value) noexcept {
+#ifdef MRT_BOUNDED_TELEMETRY
+            if (false == std::is_constant_evaluated()) {
+                return telemetry::record<t_bounded, t_constraint>(value, t_constraint{}(value));
+            }
+#endif
+            return t_constraint{}(value);
+        }
+    }
+
     template<typename t_bounded, typename t_constraint>
     std::ostream& operator<<(std::ostream& out, const bounded<t_bounded, t_constraint>& bounded_value) {
         return out << bounded_value.m_value;
@@ -153,6 +388,33 @@ namespace mrt { namespace types { namespace bounded {
     
     template<typename t_bounded, t_bounded lower_bound, t_bounded upper_bound>
     using bounded_range = bounded<t_bounded, range_constraint<t_bounded, lower_bound, upper_bound>>;
+
+    // Compile-time checked constant: an out of range value does not compile,
+    // and nothing is checked again at run time (nor counted by telemetry).
+    template<typename t_bounded_type, typename t_bounded_type::value_type value>
+    constexpr t_bounded_type make_bounded() noexcept {
+        static_assert(typename t_bounded_type::constraint_type{}(value), "Value is out of constraint range.");
+
+        t_bounded_type result;
+        detail::bounded_access::store_unchecked(result, value);
+        return result;
+    }
+
+    template<typename t_bounded_type, typename t_bounded_type::value_type value>
+    inline constexpr t_bounded_type bounded_constant = make_bounded<t_bounded_type, value>();
+
+    // Builds { bounded(generator(0)), ..., bounded(generator(count - 1)) }.
+    // Used to initialize a constexpr variable, any generated value outside
+    // the constraint, or outside value_type before conversion, is a compile
+    // error.
+    template<typename t_bounded_type, std::size_t count, typename t_generator>
+    constexpr std::array<t_bounded_type, count> make_table(t_generator&& generator) {
+        using value_type = typename t_bounded_type::value_type;
+
+        return [&generator]<std::size_t... indices>(std::index_sequence<indices...>) {
+            return std::array<t_bounded_type, count>{ t_bounded_type(static_cast<value_type>(detail::checked_narrow<value_type>(generator(indices))))... };
+        }(std::make_index_sequence<count>{});
+    }
 } } }
 
 #endif
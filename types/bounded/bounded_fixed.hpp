@@ -0,0 +1,209 @@
+#ifndef MRT_TYPES_BOUNDED_BOUNDED_FIXED_HPP_
+#define MRT_TYPES_BOUNDED_BOUNDED_FIXED_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mrt { namespace types { namespace bounded {
+    namespace detail {
+        constexpr std::int64_t fixed_floor(double value) noexcept {
+            const auto truncated = static_cast<std::int64_t>(value);
+            return static_cast<double>(truncated) > value ? truncated - 1 : truncated;
+        }
+
+        constexpr std::int64_t fixed_ceil(double value) noexcept {
+            const auto truncated = static_cast<std::int64_t>(value);
+            return static_cast<double>(truncated) < value ? truncated + 1 : truncated;
+        }
+
+        constexpr std::int64_t fixed_round(double value) noexcept {
+            return value >= 0 ? fixed_floor(value + 0.5) : -fixed_floor(-value + 0.5);
+        }
+
+        // Rounds to nearest; the arithmetic shift keeps negative products
+        // consistent with positive ones.
+        template<unsigned precision, typename t_wide = std::int64_t>
+        constexpr t_wide fixed_multiply(t_wide left, t_wide right) noexcept {
+            return (left * right + ((t_wide{ 1 } << precision) >> 1)) >> precision;
+        }
+
+        // Narrowest integer holding every raw value of the range.
+        template<std::int64_t raw_lower, std::int64_t raw_upper>
+        using fixed_storage_t =
+            std::conditional_t<(raw_lower >= 0),
+                std::conditional_t<(raw_upper <= std::numeric_limits<std::uint8_t>::max()), std::uint8_t,
+                std::conditional_t<(raw_upper <= std::numeric_limits<std::uint16_t>::max()), std::uint16_t, std::uint32_t>>,
+                std::conditional_t<(raw_lower >= std::numeric_limits<std::int8_t>::min() && raw_upper <= std::numeric_limits<std::int8_t>::max()), std::int8_t,
+                std::conditional_t<(raw_lower >= std::numeric_limits<std::int16_t>::min() && raw_upper <= std::numeric_limits<std::int16_t>::max()), std::int16_t, std::int32_t>>>;
+    }
+
+    // Fixed-point number restricted to [lower_bound, upper_bound] with at
+    // least precision fractional bits. The value is stored as raw / 2^precision
+    // in the narrowest integer type that holds the range, so [0, 1] with 15
+    // bits fits in 16 bits. Arithmetic is integer only and throws
+    // std::range_error like bounded when a result leaves the range.
+    template<double lower_bound, double upper_bound, unsigned precision>
+    class bounded_fixed {
+        static_assert(lower_bound <= upper_bound, "Lower bound must be lower or equal to upper bound");
+        static_assert(precision <= 31, "Precision must be at most 31 fractional bits");
+
+    public:
+        static constexpr unsigned fraction_bits = precision;
+        static constexpr std::int64_t scale = std::int64_t{ 1 } << precision;
+        static constexpr std::int64_t raw_lower = detail::fixed_ceil(lower_bound * scale);
+        static constexpr std::int64_t raw_upper = detail::fixed_floor(upper_bound * scale);
+
+        static_assert(raw_lower <= raw_upper, "Range holds no value at this precision");
+        static_assert(raw_lower >= std::numeric_limits<std::int32_t>::min() && raw_upper <= std::numeric_limits<std::int32_t>::max(),
+                      "Range and precision need more than 32 bits of storage");
+
+        using storage_type = detail::fixed_storage_t<raw_lower, raw_upper>;
+        using wide_type = std::int64_t;
+
+    private:
+        // The batch kernels compute in 32 bits whenever the range allows it,
+        // which doubles the lanes per vector compared to 64-bit lanes.
+        static constexpr wide_type magnitude = raw_upper > -raw_lower ? raw_upper : -raw_lower;
+        static constexpr wide_type int32_max = std::numeric_limits<std::int32_t>::max();
+
+        using sum_type = std::conditional_t<(2 * magnitude <= int32_max), std::int32_t, wide_type>;
+        using product_type = std::conditional_t<(magnitude * magnitude + scale / 2 <= int32_max), std::int32_t, wide_type>;
+
+        // The kernels convert raw operands to these types without checks:
+        // each must be at least as wide as storage_type and hold the largest
+        // sum or rounded product of two raw values.
+        static_assert(sizeof(sum_type) >= sizeof(storage_type) && std::is_signed_v<sum_type>, "Sum type narrower than the storage");
+        static_assert(sizeof(product_type) >= sizeof(storage_type) && std::is_signed_v<product_type>, "Product type narrower than the storage");
+        static_assert(2 * magnitude <= std::numeric_limits<sum_type>::max(), "Sum type cannot hold the sum of two raw values");
+        static_assert(magnitude * magnitude + scale / 2 <= std::numeric_limits<product_type>::max(), "Product type cannot hold the product of two raw values");
+
+        // Products of two values of the range stay in the range (e.g. gains
+        // in [0, 1]), so multiplication never needs a range check.
+        static constexpr bool closed_under_multiply = [] {
+            const wide_type corners[] = {
+                detail::fixed_multiply<precision>(raw_lower, raw_lower),
+                detail::fixed_multiply<precision>(raw_lower, raw_upper),
+                detail::fixed_multiply<precision>(raw_upper, raw_upper)
+            };
+
+            for (const auto corner : corners) {
+                if (corner < raw_lower || corner > raw_upper) {
+                    return false;
+                }
+            }
+
+            return true;
+        }();
+
+    public:
+        bounded_fixed() = default;
+
+        constexpr explicit bounded_fixed(double value) {
+            if (!(value >= lower_bound && value <= upper_bound)) {
+                throw std::range_error("Value is out of constraint range.");
+            }
+
+            m_raw = static_cast<storage_type>(std::clamp(detail::fixed_round(value * scale), raw_lower, raw_upper));
+        }
+
+        static constexpr bounded_fixed from_raw(wide_type raw) {
+            bounded_fixed result;
+            result.m_raw = checked(raw);
+            return result;
+        }
+
+        constexpr storage_type raw() const noexcept {
+            return m_raw;
+        }
+
+        constexpr double value() const noexcept {
+            return static_cast<double>(m_raw) / scale;
+        }
+
+        constexpr explicit operator double() const noexcept {
+            return value();
+        }
+
+    public:
+        constexpr bounded_fixed operator+(const bounded_fixed& other) const {
+            return from_raw(wide_type{ m_raw } + other.m_raw);
+        }
+
+        constexpr bounded_fixed operator-(const bounded_fixed& other) const {
+            return from_raw(wide_type{ m_raw } - other.m_raw);
+        }
+
+        constexpr bounded_fixed operator*(const bounded_fixed& other) const {
+            const wide_type product = detail::fixed_multiply<precision>(m_raw, other.m_raw);
+
+            if constexpr (closed_under_multiply) {
+                return unchecked(product);
+            } else {
+                return from_raw(product);
+            }
+        }
+
+        constexpr bounded_fixed operator/(const bounded_fixed& other) const {
+            if (other.m_raw == 0) {
+                throw std::range_error("Division by zero.");
+            }
+
+            return from_raw((wide_type{ m_raw } * scale) / other.m_raw);
+        }
+
+        constexpr bool operator==(const bounded_fixed& other) const noexcept {
+            return m_raw == other.m_raw;
+        }
+
+        constexpr auto operator<=>(const bounded_fixed& other) const noexcept {
+            return m_raw <=> other.m_raw;
+        }
+
+    public:
+        // Batch kernels: out[i] = left[i] <op> right[i], clamped to the range
+        // instead of throwing. The loops are branch free over the raw
+        // integers so they vectorize with integer SIMD. All spans must have
+        // the same size.
+
+        static void add_saturated(std::span<const bounded_fixed> left, std::span<const bounded_fixed> right,
+                                  std::span<bounded_fixed> out) noexcept {
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                const auto sum = static_cast<sum_type>(static_cast<sum_type>(left[i].m_raw) + right[i].m_raw);
+                out[i].m_raw = static_cast<storage_type>(std::clamp(sum, static_cast<sum_type>(raw_lower), static_cast<sum_type>(raw_upper)));
+            }
+        }
+
+        static void multiply_saturated(std::span<const bounded_fixed> left, std::span<const bounded_fixed> right,
+                                       std::span<bounded_fixed> out) noexcept {
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                const auto product = detail::fixed_multiply<precision, product_type>(left[i].m_raw, right[i].m_raw);
+                out[i].m_raw = static_cast<storage_type>(std::clamp(product, static_cast<product_type>(raw_lower), static_cast<product_type>(raw_upper)));
+            }
+        }
+
+    private:
+        static constexpr storage_type checked(wide_type raw) {
+            if (raw < raw_lower || raw > raw_upper) {
+                throw std::range_error("Value is out of constraint range.");
+            }
+
+            return static_cast<storage_type>(raw);
+        }
+
+        static constexpr bounded_fixed unchecked(wide_type raw) noexcept {
+            bounded_fixed result;
+            result.m_raw = static_cast<storage_type>(raw);
+            return result;
+        }
+
+    private:
+        storage_type m_raw;
+    };
+} } }
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef MRT_TYPES_BOUNDED_BOUNDED_MAP_HPP_
+#define MRT_TYPES_BOUNDED_BOUNDED_MAP_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "bounded.hpp"
+#include "bounded_set.hpp"
+
+namespace mrt { namespace types { namespace bounded {
+    template<typename t_key, typename t_value>
+    class bounded_map;
+
+    // Map keyed by a bounded_range: one slot per value of the range, so a
+    // lookup is a subtraction and an index. The occupied slots are tracked
+    // by a bounded_set, which also drives iteration. The slots are allocated
+    // on the first insertion, so wide ranges do not make the map itself large.
+    template<typename t_bounded, t_bounded lower_bound, t_bounded upper_bound, typename t_value>
+    class bounded_map<bounded<t_bounded, range_constraint<t_bounded, lower_bound, upper_bound>>, t_value> {
+    public:
+        using key_type = bounded_range<t_bounded, lower_bound, upper_bound>;
+        using mapped_type = t_value;
+        using size_type = std::size_t;
+
+    private:
+        using occupancy_type = bounded_set<key_type>;
+        using allocator_type = std::allocator<t_value>;
+
+    public:
+        static constexpr size_type capacity = occupancy_type::capacity;
+
+        template<typename t_map, typename t_mapped>
+        class basic_iterator {
+        public:
+            using value_type = t_value;
+            using difference_type = std::ptrdiff_t;
+            using pointer = t_mapped*;
+            using reference = t_mapped&;
+            using iterator_category = std::forward_iterator_tag;
+
+        private:
+            t_map* map;
+            typename occupancy_type::iterator position;
+
+        public:
+            basic_iterator() noexcept : map{}, position{} {}
+            basic_iterator(t_map* map, typename occupancy_type::iterator position) noexcept : map{ map }, position{ position } {}
+
+            key_type key() const noexcept {
+                return *position;
+            }
+
+            reference operator*() const noexcept {
+                return map->m_slots[position.index()];
+            }
+
+            pointer operator->() const noexcept {
+                return std::addressof(operator*());
+            }
+
+            basic_iterator& operator++() noexcept {
+                ++position;
+                return *this;
+            }
+
+            basic_iterator operator++(int) noexcept {
+                basic_iterator previous{ *this };
+                ++position;
+                return previous;
+            }
+
+            bool operator==(const basic_iterator& other) const noexcept {
+                return position == other.position;
+            }
+
+            bool operator!=(const basic_iterator& other) const noexcept {
+                return !(*this == other);
+            }
+        };
+
+        using iterator = basic_iterator<bounded_map, t_value>;
+        using const_iterator = basic_iterator<const bounded_map, const t_value>;
+
+    private:
+        occupancy_type m_occupied;
+        t_value* m_slots{ nullptr };
+
+    public:
+        bounded_map() = default;
+
+        bounded_map(const bounded_map& other) {
+            for (const auto key : other.m_occupied) {
+                insert(key, other.m_slots[occupancy_type::index_of(key)]);
+            }
+        }
+
+        bounded_map(bounded_map&& other) noexcept
+            : m_occupied{ other.m_occupied }, m_slots{ std::exchange(other.m_slots, nullptr) } {
+            other.m_occupied.clear();
+        }
+
+        bounded_map& operator=(const bounded_map& other) {
+            if (this == &other) return *this;
+
+            clear();
+            for (const auto key : other.m_occupied) {
+                insert(key, other.m_slots[occupancy_type::index_of(key)]);
+            }
+
+            return *this;
+        }
+
+        bounded_map& operator=(bounded_map&& other) noexcept {
+            if (this == &other) return *this;
+
+            release();
+            m_occupied = other.m_occupied;
+            m_slots = std::exchange(other.m_slots, nullptr);
+            other.m_occupied.clear();
+
+            return *this;
+        }
+
+        ~bounded_map() {
+            release();
+        }
+
+        template<typename... t_args>
+        std::pair<iterator, bool> emplace(const key_type& key, t_args&&... args) {
+            const auto index = occupancy_type::index_of(key);
+
+            if (m_occupied.test(index)) {
+                return { make_iterator(index), false };
+            }
+
+            if (m_slots == nullptr) {
+                m_slots = allocator_type{}.allocate(capacity);
+            }
+
+            std::construct_at(m_slots + index, std::forward<t_args>(args)...);
+            m_occupied.insert_index(index);
+            return { make_iterator(index), true };
+        }
+
+        bool insert(const key_type& key, const t_value& value) {
+            return emplace(key, value).second;
+        }
+
+        bool insert(const key_type& key, t_value&& value) {
+            return emplace(key, std::move(value)).second;
+        }
+
+        t_value& operator[](const key_type& key) {
+            return *emplace(key).first;
+        }
+
+        t_value& at(const key_type& key) {
+            const auto index = occupancy_type::index_of(key);
+
+            if (!m_occupied.test(index)) {
+                throw std::out_of_range("Key is not in the map.");
+            }
+
+            return m_slots[index];
+        }
+
+        const t_value& at(const key_type& key) const {
+            const auto index = occupancy_type::index_of(key);
+
+            if (!m_occupied.test(index)) {
+                throw std::out_of_range("Key is not in the map.");
+            }
+
+            return m_slots[index];
+        }
+
+        t_value* find(const key_type& key) noexcept {
+            const auto index = occupancy_type::index_of(key);
+            return m_occupied.test(index) ? m_slots + index : nullptr;
+        }
+
+        const t_value* find(const key_type& key) const noexcept {
+            const auto index = occupancy_type::index_of(key);
+            return m_occupied.test(index) ? m_slots + index : nullptr;
+        }
+
+        bool contains(const key_type& key) const noexcept {
+            return m_occupied.contains(key);
+        }
+
+        bool erase(const key_type& key) {
+            const auto index = occupancy_type::index_of(key);
+
+            if (!m_occupied.erase_index(index)) {
+                return false;
+            }
+
+            std::destroy_at(m_slots + index);
+            return true;
+        }
+
+        void clear() {
+            for (const auto key : m_occupied) {
+                std::destroy_at(m_slots + occupancy_type::index_of(key));
+            }
+
+            m_occupied.clear();
+        }
+
+        size_type size() const noexcept {
+            return m_occupied.size();
+        }
+
+        bool empty() const noexcept {
+            return m_occupied.empty();
+        }
+
+        iterator begin() noexcept {
+            return iterator{ this, m_occupied.begin() };
+        }
+
+        iterator end() noexcept {
+            return iterator{ this, m_occupied.end() };
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator{ this, m_occupied.begin() };
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator{ this, m_occupied.end() };
+        }
+
+    private:
+        void release() noexcept {
+            clear();
+
+            if (m_slots != nullptr) {
+                allocator_type{}.deallocate(m_slots, capacity);
+                m_slots = nullptr;
+            }
+        }
+
+        iterator make_iterator(size_type index) noexcept {
+            return iterator{ this, m_occupied.lower_bound_index(index) };
+        }
+    };
+} } }
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef MRT_TYPES_BOUNDED_BOUNDED_SET_HPP_
+#define MRT_TYPES_BOUNDED_BOUNDED_SET_HPP_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "bounded.hpp"
+
+namespace mrt { namespace types { namespace bounded {
+    template<typename t_key>
+    class bounded_set;
+
+    // Set of keys from a bounded_range, stored as one bit per value of the
+    // range. Iteration walks the set bits in key order.
+    template<typename t_bounded, t_bounded lower_bound, t_bounded upper_bound>
+    class bounded_set<bounded<t_bounded, range_constraint<t_bounded, lower_bound, upper_bound>>> {
+        static_assert(std::is_integral_v<t_bounded>, "bounded_set keys must be integral");
+
+        using word_type = std::uint64_t;
+        using unsigned_type = std::make_unsigned_t<t_bounded>;
+
+    public:
+        using key_type = bounded_range<t_bounded, lower_bound, upper_bound>;
+        using value_type = key_type;
+        using size_type = std::size_t;
+
+        static constexpr std::uint64_t domain_size =
+            static_cast<std::uint64_t>(static_cast<unsigned_type>(upper_bound) - static_cast<unsigned_type>(lower_bound)) + 1;
+
+        static_assert(domain_size != 0 && domain_size <= (std::uint64_t{ 1 } << 24), "Key range is too large for a flat table");
+
+        static constexpr size_type capacity = static_cast<size_type>(domain_size);
+
+    private:
+        static constexpr size_type word_bits = 64;
+        static constexpr size_type word_count = (capacity + word_bits - 1) / word_bits;
+
+    public:
+        class iterator {
+        public:
+            using value_type = key_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const key_type*;
+            using reference = key_type;
+            using iterator_category = std::forward_iterator_tag;
+
+        private:
+            const word_type* words;
+            size_type word;
+            word_type remaining;
+
+        public:
+            iterator() noexcept : words{}, word{ word_count }, remaining{} {}
+
+            // Positioned on the first element whose index is at least index.
+            iterator(const word_type* words, size_type index) noexcept : words{ words }, word{ index / word_bits }, remaining{} {
+                if (word < word_count) {
+                    remaining = words[word] & (~word_type{ 0 } << (index % word_bits));
+                    skip_empty_words();
+                }
+            }
+
+            size_type index() const noexcept {
+                return word * word_bits + static_cast<size_type>(std::countr_zero(remaining));
+            }
+
+            key_type operator*() const noexcept {
+                return bounded_set::key_at(index());
+            }
+
+            iterator& operator++() noexcept {
+                remaining &= remaining - 1;
+                skip_empty_words();
+                return *this;
+            }
+
+            iterator operator++(int) noexcept {
+                iterator previous{ *this };
+                operator++();
+                return previous;
+            }
+
+            bool operator==(const iterator& other) const noexcept {
+                return word == other.word && remaining == other.remaining;
+            }
+
+            bool operator!=(const iterator& other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            void skip_empty_words() noexcept {
+                while (remaining == 0 && ++word < word_count) {
+                    remaining = words[word];
+                }
+
+                if (word >= word_count) {
+                    word = word_count;
+                    remaining = 0;
+                }
+            }
+        };
+
+        using const_iterator = iterator;
+
+    private:
+        std::array<word_type, word_count> m_words{};
+        size_type m_size{ 0 };
+
+    public:
+        static size_type index_of(const key_type& key) noexcept {
+            return static_cast<size_type>(static_cast<unsigned_type>(key.value()) - static_cast<unsigned_type>(lower_bound));
+        }
+
+        static key_type key_at(size_type index) noexcept {
+            key_type key;
+            detail::bounded_access::store_unchecked(key, static_cast<t_bounded>(static_cast<unsigned_type>(lower_bound) + static_cast<unsigned_type>(index)));
+            return key;
+        }
+
+        bool contains(const key_type& key) const noexcept {
+            return test(index_of(key));
+        }
+
+        bool insert(const key_type& key) noexcept {
+            return insert_index(index_of(key));
+        }
+
+        bool erase(const key_type& key) noexcept {
+            return erase_index(index_of(key));
+        }
+
+        void clear() noexcept {
+            m_words = {};
+            m_size = 0;
+        }
+
+        size_type size() const noexcept {
+            return m_size;
+        }
+
+        bool empty() const noexcept {
+            return m_size == 0;
+        }
+
+        iterator begin() const noexcept {
+            return iterator{ m_words.data(), 0 };
+        }
+
+        iterator end() const noexcept {
+            return iterator{};
+        }
+
+        // Index based access for containers layered on top of the set.
+        bool test(size_type index) const noexcept {
+            return (m_words[index / word_bits] >> (index % word_bits)) & 1u;
+        }
+
+        bool insert_index(size_type index) noexcept {
+            const word_type mask = word_type{ 1 } << (index % word_bits);
+            word_type& word = m_words[index / word_bits];
+
+            if (word & mask) {
+                return false;
+            }
+
+            word |= mask;
+            ++m_size;
+            return true;
+        }
+
+        iterator lower_bound_index(size_type index) const noexcept {
+            return iterator{ m_words.data(), index };
+        }
+
+        bool erase_index(size_type index) noexcept {
+            const word_type mask = word_type{ 1 } << (index % word_bits);
+            word_type& word = m_words[index / word_bits];
+
+            if (!(word & mask)) {
+                return false;
+            }
+
+            word &= ~mask;
+            --m_size;
+            return true;
+        }
+    };
+} } }
+
+#endif
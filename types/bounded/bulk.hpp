@@ -0,0 +1,82 @@
+#ifndef MRT_TYPES_BOUNDED_BULK_HPP_
+#define MRT_TYPES_BOUNDED_BULK_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+#include "bounded.hpp"
+
+namespace mrt { namespace types { namespace bounded {
+    namespace detail {
+        constexpr std::size_t validation_block = 64;
+
+        // No early exit inside a block: the compiler turns this into packed
+        // min/max compares (SSE/AVX/NEON depending on the target flags).
+        // Negated compares keep NaN out of range, as range_constraint does.
+        template<typename t_constraint, typename t_bounded>
+        bool block_in_range(const t_bounded* values) noexcept {
+            unsigned outside{ 0 };
+
+            for (std::size_t i = 0; i < validation_block; ++i) {
+                outside |= static_cast<unsigned>(!(values[i] >= t_constraint::lower))
+                         | static_cast<unsigned>(!(values[i] <= t_constraint::upper));
+            }
+
+            return outside == 0;
+        }
+    }
+
+    // Returns the index of the first value rejected by the constraint of
+    // t_bounded_type, or values.size() when every value is accepted.
+    template<typename t_bounded_type>
+    std::size_t validate(std::span<const typename t_bounded_type::value_type> values) noexcept {
+        using constraint_type = typename t_bounded_type::constraint_type;
+
+        const auto first = values.data();
+        const auto count = values.size();
+        std::size_t index{ 0 };
+
+        if constexpr (detail::is_range_constraint<constraint_type>::value) {
+            while (index + detail::validation_block <= count
+                   && detail::block_in_range<constraint_type>(first + index)) {
+                index += detail::validation_block;
+            }
+        }
+
+        const constraint_type constraint{};
+        for (; index < count; ++index) {
+            if (false == constraint(first[index])) {
+                return index;
+            }
+        }
+
+        return count;
+    }
+
+    // Converts values into out without throwing. Values are copied up to the
+    // first violation or until out is full; the returned count is
+    // min(values.size(), out.size()) on success.
+    template<typename t_bounded, typename t_constraint, std::size_t t_extent>
+    std::size_t from_span(std::span<const t_bounded> values, std::span<bounded<t_bounded, t_constraint>, t_extent> out) noexcept {
+        const std::size_t count = std::min(values.size(), out.size());
+        const std::size_t valid = validate<bounded<t_bounded, t_constraint>>(values.first(count));
+
+#ifdef MRT_BOUNDED_TELEMETRY
+        // validate() checks whole blocks at once; replay what it accepted,
+        // and the first violation, through the counters.
+        for (std::size_t i = 0; i < valid + (valid < count ? 1 : 0); ++i) {
+            detail::check_constraint<t_bounded, t_constraint>(values[i]);
+        }
+#endif
+
+
+        for (std::size_t i = 0; i < valid; ++i) {
+            detail::bounded_access::store_unchecked(out[i], values[i]);
+        }
+
+        return valid;
+    }
+} } }
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef MRT_TYPES_BOUNDED_CHARCONV_HPP_
+#define MRT_TYPES_BOUNDED_CHARCONV_HPP_
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <span>
+#include <system_error>
+
+#include "bounded.hpp"
+
+namespace mrt { namespace types { namespace bounded {
+    // Locale-independent counterparts of operator>> and operator<<. Nothing
+    // here throws: a value outside the constraint is reported as
+    // std::errc::result_out_of_range and leaves the target untouched, the
+    // same way std::from_chars treats values that do not fit the type.
+
+    template<typename t_bounded, typename t_constraint>
+    std::from_chars_result parse_bounded(const char* first, const char* last, bounded<t_bounded, t_constraint>& out) noexcept {
+        t_bounded raw_value{};
+        auto result = std::from_chars(first, last, raw_value);
+
+        if (result.ec != std::errc{}) {
+            return result;
+        }
+
+        if (false == detail::check_constraint<t_bounded, t_constraint>(raw_value)) {
+            result.ec = std::errc::result_out_of_range;
+            return result;
+        }
+
+        detail::bounded_access::store_unchecked(out, raw_value);
+        return result;
+    }
+
+    template<typename t_bounded, typename t_constraint>
+    std::to_chars_result format_to(char* first, char* last, const bounded<t_bounded, t_constraint>& bounded_value) noexcept {
+        return std::to_chars(first, last, bounded_value.value());
+    }
+
+    struct parse_delimited_result {
+        std::size_t count;
+        const char* ptr;
+        std::errc ec;
+    };
+
+    namespace detail {
+        inline const char* skip_blanks(const char* first, const char* last, char delimiter) noexcept {
+            while (first != last && *first != delimiter && (*first == ' ' || *first == '\t')) {
+                ++first;
+            }
+
+            return first;
+        }
+    }
+
+    // Decodes fields separated by delimiter into out, stopping when out is
+    // full, the input is exhausted or a field is invalid. Spaces and tabs
+    // around fields are ignored. On error, ptr points at the start of the
+    // offending field, which is neither counted nor stored, and count holds
+    // the number of values decoded before it. When out fills
+    // up first, ptr is where decoding should resume.
+    // When the input arrives in chunks, pass last_chunk = false for all but
+    // the final one: a trailing field with no delimiter after it may continue
+    // in the next chunk, so it is left undecoded and ptr points at its start.
+    template<typename t_bounded, typename t_constraint, std::size_t t_extent>
+    parse_delimited_result parse_delimited(const char* first, const char* last, char delimiter,
+                                           std::span<bounded<t_bounded, t_constraint>, t_extent> out,
+                                           bool last_chunk = true) noexcept {
+        std::size_t count{ 0 };
+
+        while (count < out.size()) {
+            first = detail::skip_blanks(first, last, delimiter);
+            if (first == last) {
+                break;
+            }
+
+            if (false == last_chunk && std::find(first, last, delimiter) == last) {
+                break;
+            }
+
+            bounded<t_bounded, t_constraint> value{};
+            auto field = parse_bounded(first, last, value);
+            if (field.ec != std::errc{}) {
+                return { count, first, field.ec };
+            }
+
+            // Trailing characters make the whole field invalid, so nothing
+            // is stored before the delimiter is seen.
+            const char* next = detail::skip_blanks(field.ptr, last, delimiter);
+            if (next != last && *next != delimiter) {
+                return { count, first, std::errc::invalid_argument };
+            }
+
+            detail::bounded_access::store_unchecked(out[count], value.value());
+            ++count;
+            first = next;
+
+            if (first == last) {
+                break;
+            }
+
+            ++first;
+        }
+
+        return { count, first, std::errc{} };
+    }
+} } }
+
+#endif
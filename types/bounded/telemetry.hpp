@@ -0,0 +1,198 @@
+#ifndef MRT_TYPES_BOUNDED_TELEMETRY_HPP_
+#define MRT_TYPES_BOUNDED_TELEMETRY_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+// Opt-in instrumentation of bounded::assign, parse_bounded and from_span.
+// Define MRT_BOUNDED_TELEMETRY before including bounded.hpp to count checks,
+// violations and near-boundary values per bounded instantiation. Every
+// translation unit using a given bounded specialization must see the same
+// setting, or its members get two definitions; defining the macro for the
+// whole program is the simplest way to ensure that.
+// Without it bounded.hpp does not include this header at all.
+
+#ifndef MRT_BOUNDED_TELEMETRY_SAMPLE_RATE
+#define MRT_BOUNDED_TELEMETRY_SAMPLE_RATE 64
+#endif
+
+#ifndef MRT_BOUNDED_TELEMETRY_NEAR_DIVISOR
+#define MRT_BOUNDED_TELEMETRY_NEAR_DIVISOR 16
+#endif
+
+namespace mrt { namespace types { namespace bounded { namespace telemetry {
+    // One violation out of sample_rate has its value captured.
+    constexpr std::uint64_t sample_rate = MRT_BOUNDED_TELEMETRY_SAMPLE_RATE;
+
+    // Accepted values closer to a bound than (upper - lower) / near_divisor
+    // are counted as near-boundary hits.
+    constexpr long double near_divisor = MRT_BOUNDED_TELEMETRY_NEAR_DIVISOR;
+
+    constexpr std::size_t sample_capacity = 8;
+
+    class counters {
+    public:
+        std::atomic<std::uint64_t> checks{ 0 };
+        std::atomic<std::uint64_t> violations{ 0 };
+        std::atomic<std::uint64_t> near_boundary{ 0 };
+        std::atomic<std::uint64_t> samples_taken{ 0 };
+        std::array<std::atomic<double>, sample_capacity> samples{};
+
+        const std::type_info& type;
+        const bool has_range;
+        const long double lower;
+        const long double upper;
+        counters* next{ nullptr };
+
+        counters(const std::type_info& type, bool has_range, long double lower, long double upper) noexcept
+            : type{ type }, has_range{ has_range }, lower{ lower }, upper{ upper } {}
+
+        void sample(double value) noexcept {
+            const auto slot = samples_taken.fetch_add(1, std::memory_order_relaxed) % sample_capacity;
+            samples[slot].store(value, std::memory_order_relaxed);
+        }
+
+        void reset() noexcept {
+            checks.store(0, std::memory_order_relaxed);
+            violations.store(0, std::memory_order_relaxed);
+            near_boundary.store(0, std::memory_order_relaxed);
+            samples_taken.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    class registry {
+    public:
+        static void add(counters& entry) noexcept {
+            entry.next = head().load(std::memory_order_relaxed);
+            while (!head().compare_exchange_weak(entry.next, &entry, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+
+        template<typename t_function>
+        static void for_each(t_function&& function) {
+            for (counters* entry = head().load(std::memory_order_acquire); entry != nullptr; entry = entry->next) {
+                function(static_cast<const counters&>(*entry));
+            }
+        }
+
+        static void reset() noexcept {
+            for (counters* entry = head().load(std::memory_order_acquire); entry != nullptr; entry = entry->next) {
+                entry->reset();
+            }
+        }
+
+        static void dump(std::ostream& out) {
+            for_each([&out](const counters& entry) {
+                out << type_name(entry.type);
+
+                if (entry.has_range) {
+                    out << " [" << entry.lower << ", " << entry.upper << "]";
+                }
+
+                out << " checks=" << entry.checks.load(std::memory_order_relaxed)
+                    << " violations=" << entry.violations.load(std::memory_order_relaxed)
+                    << " near_boundary=" << entry.near_boundary.load(std::memory_order_relaxed);
+
+                const auto taken = entry.samples_taken.load(std::memory_order_relaxed);
+                if (taken != 0) {
+                    out << " samples=";
+
+                    const auto count = taken < sample_capacity ? taken : sample_capacity;
+                    for (std::uint64_t i = 0; i < count; ++i) {
+                        out << (i == 0 ? "" : ",") << entry.samples[i].load(std::memory_order_relaxed);
+                    }
+                }
+
+                out << '\n';
+            });
+        }
+
+    private:
+        static std::atomic<counters*>& head() noexcept {
+            static std::atomic<counters*> first{ nullptr };
+            return first;
+        }
+
+        static std::string type_name(const std::type_info& type) {
+#if defined(__GNUG__)
+            int status{ 0 };
+            char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+
+            if (status == 0 && demangled != nullptr) {
+                std::string name{ demangled };
+                std::free(demangled);
+                return name;
+            }
+#endif
+            return type.name();
+        }
+    };
+
+    // One entry per bounded instantiation, registered on its first check.
+    template<typename t_bounded, typename t_constraint>
+    counters& counters_for() noexcept {
+        struct registered : counters {
+            registered() noexcept : counters{ typeid(t_constraint), has_range(), range_lower(), range_upper() } {
+                registry::add(*this);
+            }
+
+            static constexpr bool has_range() noexcept {
+                return requires { t_constraint::lower; t_constraint::upper; };
+            }
+
+            static constexpr long double range_lower() noexcept {
+                if constexpr (has_range()) return static_cast<long double>(t_constraint::lower);
+                else return 0;
+            }
+
+            static constexpr long double range_upper() noexcept {
+                if constexpr (has_range()) return static_cast<long double>(t_constraint::upper);
+                else return 0;
+            }
+        };
+
+        static registered entry;
+        return entry;
+    }
+
+    // Records one constraint check and returns accepted unchanged, so the
+    // call can wrap the check in bounded::assign.
+    template<typename t_bounded, typename t_constraint, typename t_value>
+    bool record(const t_value& value, bool accepted) noexcept {
+        auto& entry = counters_for<t_bounded, t_constraint>();
+        entry.checks.fetch_add(1, std::memory_order_relaxed);
+
+        if (false == accepted) {
+            const auto violation = entry.violations.fetch_add(1, std::memory_order_relaxed);
+
+            if constexpr (std::is_arithmetic_v<t_value>) {
+                if (violation % sample_rate == 0) {
+                    entry.sample(static_cast<double>(value));
+                }
+            }
+        } else if constexpr (std::is_arithmetic_v<t_value> && requires { t_constraint::lower; t_constraint::upper; }) {
+            constexpr long double lower = t_constraint::lower;
+            constexpr long double upper = t_constraint::upper;
+            constexpr long double margin = (upper - lower) / near_divisor;
+
+            const auto wide = static_cast<long double>(value);
+            if (wide <= lower + margin || wide >= upper - margin) {
+                entry.near_boundary.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        return accepted;
+    }
+} } } }
+
+#endif